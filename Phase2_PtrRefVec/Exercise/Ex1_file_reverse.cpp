@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Ex1_file_reverse.hpp"
+
+template <typename Func>
+double measureMs(Func f)
+{
+    auto start {std::chrono::steady_clock::now()};
+    f();
+    auto end {std::chrono::steady_clock::now()};
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+std::string readAll(const std::string& path)
+{
+    std::ifstream in {path, std::ios::binary};
+    std::ostringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+
+void writeAll(const std::string& path, const std::string& content)
+{
+    std::ofstream out {path, std::ios::binary | std::ios::trunc};
+    out << content;
+}
+
+// 在内存中按行反转 (用来验证结果)
+std::string reverseLinesInMemory(const std::string& text)
+{
+    const bool trailingNewline {!text.empty() && text.back() == '\n'};
+    std::vector<std::string> lines;
+    std::size_t start {0};
+    const std::size_t end {trailingNewline ? text.size() - 1 : text.size()};
+    while (true)
+    {
+        const std::size_t newline {text.find('\n', start)};
+        if (newline == std::string::npos || newline >= end)
+        {
+            lines.push_back(text.substr(start, end - start));
+            break;
+        }
+        lines.push_back(text.substr(start, newline - start));
+        start = newline + 1;
+    }
+    std::string result;
+    for (std::size_t i {lines.size()}; i-- > 0;)
+    {
+        result += lines[i];
+        if (i != 0)
+        {
+            result += '\n';
+        }
+    }
+    if (trailingNewline)
+    {
+        result += '\n';
+    }
+    return result;
+}
+
+// 用参数 [文件大小 MB] [线程数] 运行
+int main(int argc, char* argv[])
+{
+    const std::size_t sizeMb {argc > 1 ? static_cast<std::size_t>(std::atoll(argv[1])) : 256};
+    const std::size_t threads {argc > 2 ? static_cast<std::size_t>(std::atoll(argv[2])) : std::thread::hardware_concurrency()};
+    ThreadPool pool {threads};
+    const std::string input {"file_reverse_input.log"};
+    const std::string output {"file_reverse_output.log"};
+
+    // 1. 用很小的块 (7 字节) 验证边界情况：行比块长、空行、有无末尾换行
+    std::mt19937 rng {42};
+    bool allMatch {true};
+    for (int trial {0}; trial < 200; ++trial)
+    {
+        std::string text;
+        const int lines {static_cast<int>(rng() % 20)};
+        for (int i {0}; i < lines; ++i)
+        {
+            const std::size_t length {rng() % 4 == 0 ? rng() % 40 : rng() % 5};
+            for (std::size_t k {0}; k < length; ++k)
+            {
+                text += static_cast<char>('a' + rng() % 26);
+            }
+            if (i + 1 < lines || rng() % 2 == 0)
+            {
+                text += '\n';
+            }
+        }
+        writeAll(input, text);
+        reverseFile(input, output, FileReverseMode::Lines, pool, 7);
+        allMatch = allMatch && readAll(output) == reverseLinesInMemory(text);
+        reverseFile(input, output, FileReverseMode::Bytes, pool, 7);
+        allMatch = allMatch && readAll(output) == std::string(text.rbegin(), text.rend());
+        reverseFileInPlace(input, FileReverseMode::Lines, pool, 7);
+        allMatch = allMatch && readAll(input) == reverseLinesInMemory(text);
+    }
+    std::cout << "小文件 + 7 字节的块 (200 个随机用例): " << (allMatch ? "全部正确" : "有错误!") << '\n';
+
+    // 2. 生成一个日志文件
+    {
+        std::ofstream out {input, std::ios::binary | std::ios::trunc};
+        std::string line;
+        for (std::size_t i {0}, written {0}; written < sizeMb * 1024 * 1024; ++i)
+        {
+            line = "2024-01-01T00:00:00 INFO request " + std::to_string(i) + " handled in " + std::to_string(i % 997)
+                 + " us" + std::string(i % 50, '.') + '\n';
+            out << line;
+            written += line.size();
+        }
+    }
+    const std::string original {readAll(input)};
+    const double gb {static_cast<double>(file_reverse_detail::FileHandle(input, O_RDONLY).size()) / 1e9};
+    std::cout << "\n日志文件 " << sizeMb << " MB, " << pool.threadCount() << " 个线程, 块大小 "
+              << file_reverse_detail::kChunkSize / (1024 * 1024) << " MB\n";
+
+    // 3. 按行反转到新文件，最后一行变成第一行
+    double linesMs {measureMs([&] { reverseFile(input, output, FileReverseMode::Lines, pool); })};
+    std::ifstream reversed {output};
+    std::string firstLine;
+    std::getline(reversed, firstLine);
+    std::cout << "按行反转 (tac):     " << gb / (linesMs / 1000.0) << " GB/s, 第一行: " << firstLine << '\n';
+
+    // 4. 就地按字节反转两次，内容应该恢复原样
+    double bytesMs {measureMs([&] { reverseFileInPlace(input, FileReverseMode::Bytes, pool); })};
+    reverseFileInPlace(input, FileReverseMode::Bytes, pool);
+    std::cout << "就地按字节反转:     " << gb / (bytesMs / 1000.0) << " GB/s, 反转两次后"
+              << (readAll(input) == original ? "与原文件一致" : "与原文件不一致!") << '\n';
+
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+    return 0;
+}
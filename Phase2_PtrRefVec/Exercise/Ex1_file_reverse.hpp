@@ -0,0 +1,313 @@
+#pragma once
+
+#include <algorithm>    // std::min
+#include <cerrno>       // errno, EINTR
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t
+#include <cstring>      // std::memchr
+#include <memory>       // std::unique_ptr
+#include <string>       // std::string
+#include <system_error> // std::system_error
+#include <vector>       // std::vector
+
+#include <fcntl.h>     // open
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // pread, pwrite, close, ftruncate
+
+#include "Ex1_string_reverse.hpp"
+#include "Ex2_thread_pool.hpp"
+
+// 反转整个文件，不需要把文件读进内存 (日志文件可能有好几 GB)。
+//
+// 按字节反转 (FileReverseMode::Bytes)：把文件切成大小为 chunk 的块，
+// 第 k 块和倒数第 k 块组成一对：各自读入缓冲区、用 reverseString 的 SIMD 内核反转，再交换位置写回。
+// 不同的块对互不重叠，所以可以交给线程池并行处理；中间剩下的不足两块的部分单独反转。
+// 同时占用的内存只有 "线程数 x 2 x chunk"。
+//
+// 按行反转 (FileReverseMode::Lines，类似 tac)：行的顺序颠倒，每行的内容不变。
+// 先整体按字节反转，此时每一行的内容也被颠倒了，再把每一行反转回来：
+//   - 完全落在一个块内部的行：并行地在块的缓冲区里反转
+//   - 跨越块边界的行 (以及每块开头、结尾的残行)：最后逐行用上面的块对方法反转，
+//     所以即使一行比 chunk 还长也没有问题
+// 文件末尾的 '\n' 保持在末尾；行尾的 "\r\n" 不做特殊处理。
+//
+// 使用 pread / pwrite 而不是 mmap：每个线程只处理自己的缓冲区，
+// 不会因为映射几 GB 的地址空间而占满页表，文件被其它进程截断时也只是返回错误而不是 SIGBUS。
+enum class FileReverseMode
+{
+    Bytes,
+    Lines,
+};
+
+namespace file_reverse_detail
+{
+    constexpr std::size_t kChunkSize {4 * 1024 * 1024};
+
+    [[noreturn]] inline void throwErrno(const std::string& what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    // 文件描述符的 RAII 封装
+    class FileHandle
+    {
+    private:
+        int fd_ {-1};
+
+    public:
+        FileHandle(const std::string& path, int flags)
+            : fd_{::open(path.c_str(), flags, 0644)}
+        {
+            if (fd_ < 0)
+            {
+                throwErrno("open " + path);
+            }
+        }
+
+        ~FileHandle()
+        {
+            ::close(fd_);
+        }
+
+        FileHandle(const FileHandle&) = delete;
+        FileHandle& operator=(const FileHandle&) = delete;
+
+        int get() const { return fd_; }
+
+        std::uint64_t size() const
+        {
+            struct stat st {};
+            if (::fstat(fd_, &st) != 0)
+            {
+                throwErrno("fstat");
+            }
+            return static_cast<std::uint64_t>(st.st_size);
+        }
+    };
+
+    // 不做初始化的缓冲区 (std::vector 会先把几 MB 的内存清零，马上又被 pread 覆盖)
+    inline std::unique_ptr<char[]> makeBuffer(std::size_t bytes)
+    {
+        return std::unique_ptr<char[]>(new char[bytes]);
+    }
+
+    // pread / pwrite 可能只完成一部分 (或被信号打断)，循环直到全部完成
+    inline void readFully(int fd, char* buffer, std::size_t bytes, std::uint64_t offset)
+    {
+        while (bytes > 0)
+        {
+            const ssize_t n {::pread(fd, buffer, bytes, static_cast<off_t>(offset))};
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (n <= 0)
+            {
+                if (n == 0)
+                {
+                    errno = EIO; // 文件在处理过程中被截断
+                }
+                throwErrno("pread");
+            }
+            buffer += n;
+            bytes -= static_cast<std::size_t>(n);
+            offset += static_cast<std::uint64_t>(n);
+        }
+    }
+
+    inline void writeFully(int fd, const char* buffer, std::size_t bytes, std::uint64_t offset)
+    {
+        while (bytes > 0)
+        {
+            const ssize_t n {::pwrite(fd, buffer, bytes, static_cast<off_t>(offset))};
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (n < 0)
+            {
+                throwErrno("pwrite");
+            }
+            buffer += n;
+            bytes -= static_cast<std::size_t>(n);
+            offset += static_cast<std::uint64_t>(n);
+        }
+    }
+
+    // 就地反转文件中 [begin, end) 的字节
+    inline void reverseRange(int fd, std::uint64_t begin, std::uint64_t end, ThreadPool& pool, std::size_t chunk)
+    {
+        const std::uint64_t length {end - begin};
+        const std::size_t pairs {static_cast<std::size_t>(length / (2 * chunk))};
+        pool.parallelFor(0, pairs, 1,
+                         [fd, begin, end, chunk](std::size_t pairBegin, std::size_t pairEnd)
+                         {
+                             const auto front {makeBuffer(chunk)};
+                             const auto back {makeBuffer(chunk)};
+                             for (std::size_t p {pairBegin}; p < pairEnd; ++p)
+                             {
+                                 const std::uint64_t frontOffset {begin + p * chunk};
+                                 const std::uint64_t backOffset {end - (p + 1) * chunk};
+                                 readFully(fd, front.get(), chunk, frontOffset);
+                                 readFully(fd, back.get(), chunk, backOffset);
+                                 reverseString(front.get(), chunk);
+                                 reverseString(back.get(), chunk);
+                                 writeFully(fd, back.get(), chunk, frontOffset);
+                                 writeFully(fd, front.get(), chunk, backOffset);
+                             }
+                         });
+        // 中间不足两块的部分
+        const std::uint64_t middleBegin {begin + static_cast<std::uint64_t>(pairs) * chunk};
+        const std::size_t middle {static_cast<std::size_t>(length - 2 * static_cast<std::uint64_t>(pairs) * chunk)};
+        if (middle > 1)
+        {
+            const auto buffer {makeBuffer(middle)};
+            readFully(fd, buffer.get(), middle, middleBegin);
+            reverseString(buffer.get(), middle);
+            writeFully(fd, buffer.get(), middle, middleBegin);
+        }
+    }
+
+    // 把 in 的 [0, length) 反转后写入 out 的 [0, length)：输出的第 k 块来自输入的倒数第 k 块
+    inline void copyReversed(int in, int out, std::uint64_t length, ThreadPool& pool, std::size_t chunk)
+    {
+        const std::size_t chunks {static_cast<std::size_t>((length + chunk - 1) / chunk)};
+        pool.parallelFor(0, chunks, 1,
+                         [in, out, length, chunk](std::size_t chunkBegin, std::size_t chunkEnd)
+                         {
+                             const auto buffer {makeBuffer(chunk)};
+                             for (std::size_t k {chunkBegin}; k < chunkEnd; ++k)
+                             {
+                                 const std::uint64_t outOffset {static_cast<std::uint64_t>(k) * chunk};
+                                 const std::size_t bytes {static_cast<std::size_t>(std::min<std::uint64_t>(chunk, length - outOffset))};
+                                 readFully(in, buffer.get(), bytes, length - outOffset - bytes);
+                                 reverseString(buffer.get(), bytes);
+                                 writeFully(out, buffer.get(), bytes, outOffset);
+                             }
+                         });
+    }
+
+    // 每个块中第一个和最后一个 '\n' 的位置 (相对文件开头)，没有换行时 hasNewline 为 false
+    struct SegmentEdges
+    {
+        bool hasNewline {false};
+        std::uint64_t first {0};
+        std::uint64_t last {0};
+    };
+
+    // 整体按字节反转之后，把 [0, length) 中的每一行再反转回来
+    inline void restoreLines(int fd, std::uint64_t length, ThreadPool& pool, std::size_t chunk)
+    {
+        const std::size_t segments {static_cast<std::size_t>((length + chunk - 1) / chunk)};
+        std::vector<SegmentEdges> edges(segments);
+
+        // 第一遍 (并行)：反转每个块内部首尾两个换行之间的完整行
+        pool.parallelFor(0, segments, 1,
+                         [fd, length, chunk, &edges](std::size_t segmentBegin, std::size_t segmentEnd)
+                         {
+                             const auto buffer {makeBuffer(chunk)};
+                             for (std::size_t s {segmentBegin}; s < segmentEnd; ++s)
+                             {
+                                 const std::uint64_t offset {static_cast<std::uint64_t>(s) * chunk};
+                                 const std::size_t bytes {static_cast<std::size_t>(std::min<std::uint64_t>(chunk, length - offset))};
+                                 readFully(fd, buffer.get(), bytes, offset);
+                                 char* const data {buffer.get()};
+                                 char* const end {data + bytes};
+                                 char* lineEnd {static_cast<char*>(std::memchr(data, '\n', bytes))};
+                                 if (lineEnd == nullptr)
+                                 {
+                                     continue;
+                                 }
+                                 edges[s].hasNewline = true;
+                                 edges[s].first = offset + static_cast<std::uint64_t>(lineEnd - data);
+                                 char* lastNewline {lineEnd};
+                                 bool changed {false};
+                                 for (char* lineBegin {lineEnd + 1}; lineBegin < end; lineBegin = lineEnd + 1)
+                                 {
+                                     lineEnd = static_cast<char*>(std::memchr(lineBegin, '\n', static_cast<std::size_t>(end - lineBegin)));
+                                     if (lineEnd == nullptr)
+                                     {
+                                         break;
+                                     }
+                                     reverseString(lineBegin, static_cast<std::size_t>(lineEnd - lineBegin));
+                                     changed = true;
+                                     lastNewline = lineEnd;
+                                 }
+                                 edges[s].last = offset + static_cast<std::uint64_t>(lastNewline - data);
+                                 if (changed)
+                                 {
+                                     writeFully(fd, data, bytes, offset);
+                                 }
+                             }
+                         });
+
+        // 第二遍：剩下的行都以某个块的第一个换行结尾 (或者是文件的最后一行)，
+        // 它们可能跨越任意多个块，用块对的方法逐行反转
+        std::uint64_t lineStart {0};
+        for (const SegmentEdges& edge : edges)
+        {
+            if (edge.hasNewline)
+            {
+                reverseRange(fd, lineStart, edge.first, pool, chunk);
+                lineStart = edge.last + 1;
+            }
+        }
+        reverseRange(fd, lineStart, length, pool, chunk);
+    }
+
+    // 按行反转时文件末尾的 '\n' 不参与反转
+    inline std::uint64_t contentLength(int fd, std::uint64_t size, FileReverseMode mode)
+    {
+        if (mode == FileReverseMode::Lines && size > 0)
+        {
+            char last;
+            readFully(fd, &last, 1, size - 1);
+            if (last == '\n')
+            {
+                return size - 1;
+            }
+        }
+        return size;
+    }
+}
+
+// 就地反转文件
+inline void reverseFileInPlace(const std::string& path, FileReverseMode mode = FileReverseMode::Bytes,
+                               ThreadPool& pool = defaultThreadPool(),
+                               std::size_t chunk = file_reverse_detail::kChunkSize)
+{
+    using namespace file_reverse_detail;
+    FileHandle file {path, O_RDWR};
+    const std::uint64_t length {contentLength(file.get(), file.size(), mode)};
+    reverseRange(file.get(), 0, length, pool, chunk);
+    if (mode == FileReverseMode::Lines)
+    {
+        restoreLines(file.get(), length, pool, chunk);
+    }
+}
+
+// 把 input 反转后写入 output，input 保持不变
+inline void reverseFile(const std::string& input, const std::string& output,
+                        FileReverseMode mode = FileReverseMode::Bytes,
+                        ThreadPool& pool = defaultThreadPool(),
+                        std::size_t chunk = file_reverse_detail::kChunkSize)
+{
+    using namespace file_reverse_detail;
+    FileHandle in {input, O_RDONLY};
+    FileHandle out {output, O_RDWR | O_CREAT | O_TRUNC};
+    const std::uint64_t size {in.size()};
+    if (::ftruncate(out.get(), static_cast<off_t>(size)) != 0)
+    {
+        throwErrno("ftruncate " + output);
+    }
+    const std::uint64_t length {contentLength(in.get(), size, mode)};
+    copyReversed(in.get(), out.get(), length, pool, chunk);
+    if (length != size)
+    {
+        writeFully(out.get(), "\n", 1, length);
+    }
+    if (mode == FileReverseMode::Lines)
+    {
+        restoreLines(out.get(), length, pool, chunk);
+    }
+}
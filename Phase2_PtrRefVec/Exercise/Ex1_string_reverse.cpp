@@ -1,7 +1,12 @@
+#include <chrono>   // 计时
 #include <iostream> // 包含输入输出流库，用于打印到控制台
+#include <string>   // std::string
+
+#include "Ex1_string_reverse.hpp" // 向量化的 reverseString 重载
 
 // 定义一个函数，用于反转字符数组（字符串）
-void reverseString(char* str)
+// (逐字节的基础版本；向量化的 reverseString 见 Ex1_string_reverse.hpp)
+void reverseString_basic(char* str)
 {
     // 检查传入的字符串是否为空指针或者是一个空字符串
     if (str == nullptr || *str == '\0')
@@ -40,6 +45,15 @@ void reverseString(char* str)
     }
 }
 
+template <typename Func>
+double measureMs(Func f)
+{
+    auto start {std::chrono::steady_clock::now()};
+    f();
+    auto end {std::chrono::steady_clock::now()};
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
 // 主函数，程序的入口点
 int main()
 {
@@ -49,9 +63,64 @@ int main()
     // 使用 std::cout 打印原始字符串
     std::cout << "原本的字符串为 " << string << '\n';
 
-    // 调用 reverseString 函数来反转 `string`
-    reverseString(string);
+    // 调用 reverseString_basic 函数来反转 `string`
+    reverseString_basic(string);
 
     // 打印反转后
     std::cout << "反转的字符串为 " << string << '\n';
+
+    // 向量化版本：C 字符串、指针 + 长度、std::string
+    reverseString(string);
+    std::cout << "再反转回来为   " << string << '\n';
+    std::string text {"The quick brown fox jumps over the lazy dog, 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ"};
+    reverseString(text);
+    std::cout << "std::string 反转: " << text << '\n';
+
+    // 各种长度 (覆盖块边界和不同的起始对齐) 都与基础版本对比
+    bool allMatch {true};
+    std::string buffer(300, '\0');
+    for (int isa {0}; isa <= static_cast<int>(string_simd::Isa::AVX2); ++isa)
+    {
+        string_simd::useIsa(static_cast<string_simd::Isa>(isa));
+        for (std::size_t offset {0}; offset < 32; ++offset)
+        {
+            for (std::size_t length {0}; length < 200; ++length)
+            {
+                for (std::size_t k {0}; k < length; ++k)
+                {
+                    buffer[offset + k] = static_cast<char>('a' + (k * 7 + offset) % 26);
+                }
+                buffer[offset + length] = '\0';
+                std::string expected {buffer.data() + offset};
+                reverseString_basic(expected.data());
+                reverseString(buffer.data() + offset);
+                allMatch = allMatch && expected == buffer.data() + offset && string_simd::length(buffer.data() + offset) == length;
+            }
+        }
+    }
+    std::cout << "与基础版本对比 (所有指令集、长度 0~199、32 种对齐): " << (allMatch ? "全部一致" : "不一致!") << '\n';
+
+    // 反转 64 MB 的缓冲区
+    const std::size_t size {64 * 1024 * 1024};
+    std::string big(size, 'x');
+    for (std::size_t i {0}; i < size; ++i)
+    {
+        big[i] = static_cast<char>('a' + i % 26);
+    }
+    const double gb {static_cast<double>(size) / 1e9};
+    std::cout << "\n反转 64 MB:\n";
+    double basicMs {measureMs([&] { reverseString_basic(big.data()); })};
+    std::cout << "逐字节 (reverseString_basic): " << gb / (basicMs / 1000.0) << " GB/s\n";
+    for (int isa {0}; isa <= static_cast<int>(string_simd::Isa::AVX2); ++isa)
+    {
+        string_simd::useIsa(static_cast<string_simd::Isa>(isa));
+        if (static_cast<int>(string_simd::activeIsa()) != isa)
+        {
+            continue;
+        }
+        double lengthMs {measureMs([&] { volatile std::size_t n {string_simd::length(big.data())}; (void)n; })};
+        double reverseMs {measureMs([&] { reverseString(big.data(), big.size()); })};
+        std::cout << string_simd::isaName(string_simd::activeIsa()) << ": strlen " << gb / (lengthMs / 1000.0)
+                  << " GB/s, 反转 " << gb / (reverseMs / 1000.0) << " GB/s\n";
+    }
 }
@@ -0,0 +1,268 @@
+#pragma once
+
+#include <algorithm> // std::swap
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::uintptr_t
+#include <string>    // std::string
+
+#if defined(__cpp_lib_span) || (__cplusplus >= 202002L && __has_include(<span>))
+#include <span> // std::span
+#define STRING_REVERSE_HAS_SPAN 1
+#else
+#define STRING_REVERSE_HAS_SPAN 0
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define STRING_SIMD_X86 1
+#else
+#define STRING_SIMD_X86 0
+#endif
+
+// 向量化的字符串反转。练习1 中的 reverseString 分两步：
+// 1. 逐字节向后找 '\0'，得到长度
+// 2. 首尾两个指针逐字节交换
+// 两步都是一次只处理一个字节。这里：
+// 1. 长度：一次比较 16 / 32 个字节是否为 0 (向量化的 strlen)
+// 2. 反转：从两端各读入 16 / 32 个字节，用 shuffle 指令把块内的字节倒序，
+//    再交换写回另一端；两端的指针相遇后，中间剩下的不足一块的部分用标量交换
+// 与 Ex2_matrix_simd.hpp 一样，每个指令集单独编译一份，运行时按 CPU 选择。
+namespace string_simd
+{
+    enum class Isa
+    {
+        Scalar,
+        SSSE3,
+        AVX2,
+    };
+
+    inline const char* isaName(Isa isa)
+    {
+        switch (isa)
+        {
+        case Isa::AVX2: return "AVX2";
+        case Isa::SSSE3: return "SSSE3";
+        default: return "Scalar";
+        }
+    }
+
+    namespace scalar
+    {
+        inline void reverse(char* data, std::size_t size)
+        {
+            if (size < 2)
+            {
+                return;
+            }
+            char* start {data};
+            char* end {data + size - 1};
+            while (start < end)
+            {
+                std::swap(*start++, *end--);
+            }
+        }
+
+        inline std::size_t length(const char* str)
+        {
+            const char* end {str};
+            while (*end != '\0')
+            {
+                ++end;
+            }
+            return static_cast<std::size_t>(end - str);
+        }
+    }
+
+#if STRING_SIMD_X86
+#if defined(__clang__) || defined(__GNUC__)
+#define STRING_SIMD_NO_ASAN __attribute__((no_sanitize_address))
+#else
+#define STRING_SIMD_NO_ASAN
+#endif
+
+    // 向量化 strlen 的思路：把指针向下对齐到块边界后按块读取。
+    // 对齐的读取不会跨越页边界，所以即使读到字符串前后的几个字节也不会访问未映射的内存
+    // (这是 glibc 等实现的标准做法)。第一块中位于字符串起点之前的字节用掩码去掉。
+    // 在不知道 '\0' 在哪里之前，最后一块不可能只读到字符串为止，所以这种越界读取是刻意的：
+    // length 内核用 STRING_SIMD_NO_ASAN 标记，AddressSanitizer 不检查这两个函数里的读取
+    // (读到的字符串之外的字节只参与比较，不会影响结果)，其他代码照常检查。
+    namespace ssse3
+    {
+        __attribute__((target("ssse3"))) inline __m128i reverse16(__m128i v)
+        {
+            const __m128i mask {_mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)};
+            return _mm_shuffle_epi8(v, mask);
+        }
+
+        __attribute__((target("ssse3"))) inline void reverse(char* data, std::size_t size)
+        {
+            char* front {data};
+            char* back {data + size};
+            while (back - front >= 32)
+            {
+                back -= 16;
+                const __m128i lo {_mm_loadu_si128(reinterpret_cast<const __m128i*>(front))};
+                const __m128i hi {_mm_loadu_si128(reinterpret_cast<const __m128i*>(back))};
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(front), reverse16(hi));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(back), reverse16(lo));
+                front += 16;
+            }
+            scalar::reverse(front, static_cast<std::size_t>(back - front));
+        }
+
+        __attribute__((target("ssse3"))) STRING_SIMD_NO_ASAN inline std::size_t length(const char* str)
+        {
+            const std::uintptr_t address {reinterpret_cast<std::uintptr_t>(str)};
+            const char* block {reinterpret_cast<const char*>(address & ~std::uintptr_t {15})};
+            const __m128i zero {_mm_setzero_si128()};
+            unsigned mask {static_cast<unsigned>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(block)), zero)))};
+            mask &= ~0u << (address & 15);
+            while (mask == 0)
+            {
+                block += 16;
+                mask = static_cast<unsigned>(
+                    _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(block)), zero)));
+            }
+            return static_cast<std::size_t>(block + __builtin_ctz(mask) - str);
+        }
+    }
+
+    namespace avx2
+    {
+        // AVX2 的 shuffle 只在每 128 位的半边内部进行：先在两个半边内各自倒序，再交换两个半边
+        __attribute__((target("avx2"))) inline __m256i reverse32(__m256i v)
+        {
+            const __m256i mask {_mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                                 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)};
+            const __m256i reversedLanes {_mm256_shuffle_epi8(v, mask)};
+            return _mm256_permute2x128_si256(reversedLanes, reversedLanes, 0x01);
+        }
+
+        __attribute__((target("avx2"))) inline void reverse(char* data, std::size_t size)
+        {
+            char* front {data};
+            char* back {data + size};
+            while (back - front >= 64)
+            {
+                back -= 32;
+                const __m256i lo {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(front))};
+                const __m256i hi {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(back))};
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(front), reverse32(hi));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(back), reverse32(lo));
+                front += 32;
+            }
+            ssse3::reverse(front, static_cast<std::size_t>(back - front));
+        }
+
+        __attribute__((target("avx2"))) STRING_SIMD_NO_ASAN inline std::size_t length(const char* str)
+        {
+            const std::uintptr_t address {reinterpret_cast<std::uintptr_t>(str)};
+            const char* block {reinterpret_cast<const char*>(address & ~std::uintptr_t {31})};
+            const __m256i zero {_mm256_setzero_si256()};
+            unsigned mask {static_cast<unsigned>(_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(block)), zero)))};
+            mask &= ~0u << (address & 31);
+            while (mask == 0)
+            {
+                block += 32;
+                mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                    _mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(block)), zero)));
+            }
+            return static_cast<std::size_t>(block + __builtin_ctz(mask) - str);
+        }
+    }
+#endif
+
+    struct KernelTable
+    {
+        Isa isa;
+        void (*reverse)(char*, std::size_t);
+        std::size_t (*length)(const char*);
+    };
+
+    inline Isa detectIsa()
+    {
+#if STRING_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return Isa::AVX2;
+        if (__builtin_cpu_supports("ssse3")) return Isa::SSSE3;
+#endif
+        return Isa::Scalar;
+    }
+
+    // 取指定指令集的内核表；请求的指令集不被支持时退回到可用的最高一级
+    inline KernelTable kernelsFor(Isa isa)
+    {
+        static const Isa best {detectIsa()};
+        if (static_cast<int>(isa) > static_cast<int>(best))
+        {
+            isa = best;
+        }
+#if STRING_SIMD_X86
+        if (isa == Isa::AVX2)
+        {
+            return {Isa::AVX2, avx2::reverse, avx2::length};
+        }
+        if (isa == Isa::SSSE3)
+        {
+            return {Isa::SSSE3, ssse3::reverse, ssse3::length};
+        }
+#endif
+        return {Isa::Scalar, scalar::reverse, scalar::length};
+    }
+
+    inline KernelTable& activeKernels()
+    {
+        static KernelTable table {kernelsFor(detectIsa())};
+        return table;
+    }
+
+    inline void useIsa(Isa isa)
+    {
+        activeKernels() = kernelsFor(isa);
+    }
+
+    inline Isa activeIsa()
+    {
+        return activeKernels().isa;
+    }
+
+    // 向量化的 strlen
+    inline std::size_t length(const char* str)
+    {
+        return activeKernels().length(str);
+    }
+}
+
+// 已知长度的版本：不需要找 '\0'，也可以反转包含 '\0' 的任意字节序列
+inline void reverseString(char* data, std::size_t size)
+{
+    if (data == nullptr)
+    {
+        return;
+    }
+    string_simd::activeKernels().reverse(data, size);
+}
+
+// C 字符串版本：先用向量化的 strlen 求长度
+inline void reverseString(char* str)
+{
+    if (str == nullptr)
+    {
+        return;
+    }
+    reverseString(str, string_simd::length(str));
+}
+
+inline void reverseString(std::string& str)
+{
+    reverseString(str.data(), str.size());
+}
+
+#if STRING_REVERSE_HAS_SPAN
+inline void reverseString(std::span<char> bytes)
+{
+    reverseString(bytes.data(), bytes.size());
+}
+#endif
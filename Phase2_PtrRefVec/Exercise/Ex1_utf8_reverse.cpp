@@ -0,0 +1,118 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "Ex1_utf8_reverse.hpp"
+
+template <typename Func>
+double measureMs(Func f)
+{
+    auto start {std::chrono::steady_clock::now()};
+    f();
+    auto end {std::chrono::steady_clock::now()};
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// 按码点的朴素版本：逐个解码，再倒序拼接
+std::string reverseByDecoding(const std::string& text)
+{
+    std::string result(text.size(), '\0');
+    std::size_t out {text.size()};
+    std::size_t i {0};
+    while (i < text.size())
+    {
+        std::uint32_t cp;
+        const std::size_t length {utf8::decode(reinterpret_cast<const unsigned char*>(text.data()) + i, text.size() - i, cp)};
+        out -= length;
+        text.copy(&result[out], length, i);
+        i += length;
+    }
+    return result;
+}
+
+void show(const char* label, std::string text, ReverseUnit unit)
+{
+    reverseUtf8(text, unit);
+    std::cout << label << text << '\n';
+}
+
+int main()
+{
+    // 1. 按字节反转会破坏中文
+    const std::string hello {"你好，世界！Hello, 世界"};
+    std::string bytes {hello};
+    reverseString(bytes);
+    std::cout << "原文:               " << hello << '\n';
+    std::cout << "按字节反转是否合法: " << (utf8::isValid(bytes) ? "是" : "否") << '\n';
+    show("按码点反转:         ", hello, ReverseUnit::CodePoint);
+
+    // 2. 组合字符、表情和国旗：按码点反转会把附加符号挪到别的字母上
+    const std::string combined {"café \U0001F468‍\U0001F469‍\U0001F467 \U0001F1E8\U0001F1F3\U0001F1EF\U0001F1F5 \U0001F44D\U0001F3FD"};
+    std::cout << "\n原文:           " << combined << '\n';
+    show("按码点反转:     ", combined, ReverseUnit::CodePoint);
+    show("按字素簇反转:   ", combined, ReverseUnit::Grapheme);
+
+    // 3. 非法的 UTF-8：抛异常，内容保持不变
+    std::string broken {"abc\xE4\xBD"};
+    try
+    {
+        reverseUtf8(broken);
+    }
+    catch (const std::invalid_argument& e)
+    {
+        std::cout << "\n截断的字符: " << e.what() << '\n';
+    }
+    std::string overlong {"\xC0\xAF"};
+    std::cout << "超长编码 C0 AF 是否合法: " << (utf8::isValid(overlong) ? "是" : "否") << '\n';
+
+    // 4. 与逐个解码的版本对比，并测量吞吐量
+    const std::size_t size {64 * 1024 * 1024};
+    struct Input
+    {
+        const char* name;
+        std::string text;
+    };
+    Input inputs[] {{"纯 ASCII           ", {}}, {"ASCII 为主 (2% 中文)", {}}, {"纯中文              ", {}}};
+    const std::string chinese {"矩阵"};
+    for (std::size_t i {0}; inputs[0].text.size() < size; ++i)
+    {
+        inputs[0].text += static_cast<char>('a' + i % 26);
+    }
+    for (std::size_t i {0}; inputs[1].text.size() < size; ++i)
+    {
+        if (i % 150 == 0)
+        {
+            inputs[1].text += chinese;
+        }
+        else
+        {
+            inputs[1].text += static_cast<char>('a' + i % 26);
+        }
+    }
+    while (inputs[2].text.size() < size)
+    {
+        inputs[2].text += chinese;
+    }
+
+    std::cout << "\n64 MB 文本 (" << string_simd::isaName(string_simd::activeIsa()) << "):\n";
+    for (Input& input : inputs)
+    {
+        const std::string expected {reverseByDecoding(input.text)};
+        const double gb {static_cast<double>(input.text.size()) / 1e9};
+        std::string copy {input.text};
+        double byteMs {measureMs([&] { reverseString(copy); })};
+        copy = input.text;
+        double decodeMs {measureMs([&] { copy = reverseByDecoding(input.text); })};
+        copy = input.text;
+        double codePointMs {measureMs([&] { reverseUtf8(copy); })};
+        const bool codePointOk {copy == expected};
+        copy = input.text;
+        double graphemeMs {measureMs([&] { reverseUtf8(copy, ReverseUnit::Grapheme); })};
+        const bool graphemeOk {copy == expected};
+        std::cout << input.name << ": 按字节 " << gb / (byteMs / 1000.0) << " GB/s, 逐个解码 "
+                  << gb / (decodeMs / 1000.0) << " GB/s, reverseUtf8 " << gb / (codePointMs / 1000.0)
+                  << " GB/s, 字素簇 " << gb / (graphemeMs / 1000.0) << " GB/s, "
+                  << (codePointOk && graphemeOk ? "结果正确" : "结果错误!") << '\n';
+    }
+    return 0;
+}
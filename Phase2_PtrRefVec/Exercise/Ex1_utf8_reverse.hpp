@@ -0,0 +1,501 @@
+#pragma once
+
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::uint8_t, std::uint32_t, std::uint64_t
+#include <cstring>   // std::memcpy
+#include <utility>   // std::swap
+#include <stdexcept> // std::invalid_argument
+#include <string>    // std::string, std::to_string
+#include <vector>    // std::vector
+
+#include "Ex1_string_reverse.hpp"
+
+// UTF-8 感知的字符串反转。
+// reverseString 按字节反转，"你好" 的 6 个字节 E4 BD A0 E5 A5 BD 会变成 BD A5 E5 A0 BD E4，
+// 已经不是合法的 UTF-8 了。正确的做法是按"字符"反转：
+//   1. 先校验输入是合法的 UTF-8 (非法输入抛 std::invalid_argument，字符串保持不变)
+//   2. 用 reverseString 的 SIMD 内核把整个缓冲区按字节反转
+//   3. 此时每个多字节字符的字节顺序也被颠倒了 (续字节在前、首字节在后)，把它们再逐个反转回来
+// 第 1 步在 AVX2 上整块校验 (见 validate_avx2)，中文等多字节文本也是每次 32 字节；
+// 第 3 步用 SIMD 一次检查 16 / 32 个字节是否全是 ASCII (最高位都为 0)，纯 ASCII 的块直接跳过。
+// 整个缓冲区都是 ASCII 时不需要第 3 步，额外开销只有一次快速的校验扫描。
+//
+// ReverseUnit::Grapheme 按"字素簇" (用户看到的一个字) 反转，例如 e + U+0301 (组合重音) 是一个 é，
+// 👨 + ZWJ + 👩 + ZWJ + 👧 是一个家庭表情，两个区域指示符是一面国旗。这里实现的是 UAX #29 的
+// 常用子集：组合附加符号、变体选择符、ZWJ 连接、肤色修饰符、标签字符和国旗；
+// 不处理韩文字母组合、CR LF 等规则。
+enum class ReverseUnit
+{
+    CodePoint,
+    Grapheme,
+};
+
+namespace utf8
+{
+    inline bool isContinuation(unsigned char byte)
+    {
+        return (byte & 0xC0) == 0x80;
+    }
+
+    // 解码 data[0..size) 开头的一个字符，返回字节数；不合法 (截断、超长编码、代理项、超出 U+10FFFF) 时返回 0
+    inline std::size_t decode(const unsigned char* data, std::size_t size, std::uint32_t& codePoint)
+    {
+        const unsigned char lead {data[0]};
+        if (lead < 0x80)
+        {
+            codePoint = lead;
+            return 1;
+        }
+        std::size_t length;
+        std::uint32_t minimum;
+        if (lead >= 0xC2 && lead <= 0xDF)
+        {
+            length = 2;
+            minimum = 0x80;
+            codePoint = lead & 0x1F;
+        }
+        else if (lead >= 0xE0 && lead <= 0xEF)
+        {
+            length = 3;
+            minimum = 0x800;
+            codePoint = lead & 0x0F;
+        }
+        else if (lead >= 0xF0 && lead <= 0xF4)
+        {
+            length = 4;
+            minimum = 0x10000;
+            codePoint = lead & 0x07;
+        }
+        else
+        {
+            return 0;
+        }
+        if (length > size)
+        {
+            return 0;
+        }
+        for (std::size_t k {1}; k < length; ++k)
+        {
+            if (!isContinuation(data[k]))
+            {
+                return 0;
+            }
+            codePoint = (codePoint << 6) | (data[k] & 0x3F);
+        }
+        if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+        {
+            return 0;
+        }
+        return length;
+    }
+
+    inline std::size_t asciiRunScalar(const unsigned char* data, std::size_t size)
+    {
+        std::size_t i {0};
+        for (; i + 8 <= size; i += 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, data + i, 8);
+            if (word & 0x8080808080808080ULL)
+            {
+                break;
+            }
+        }
+        while (i < size && data[i] < 0x80)
+        {
+            ++i;
+        }
+        return i;
+    }
+
+#if STRING_SIMD_X86
+    // movemask 取出每个字节的最高位：结果为 0 说明整块都是 ASCII
+    __attribute__((target("sse2"))) inline std::size_t asciiRunSse2(const unsigned char* data, std::size_t size)
+    {
+        std::size_t i {0};
+        for (; i + 16 <= size; i += 16)
+        {
+            const __m128i block {_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))};
+            const int mask {_mm_movemask_epi8(block)};
+            if (mask != 0)
+            {
+                return i + static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+            }
+        }
+        return i + asciiRunScalar(data + i, size - i);
+    }
+
+    __attribute__((target("avx2"))) inline std::size_t asciiRunAvx2(const unsigned char* data, std::size_t size)
+    {
+        std::size_t i {0};
+        for (; i + 64 <= size; i += 64)
+        {
+            const __m256i a {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i))};
+            const __m256i b {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32))};
+            if (_mm256_movemask_epi8(_mm256_or_si256(a, b)) != 0)
+            {
+                break;
+            }
+        }
+        return i + asciiRunSse2(data + i, size - i);
+    }
+#endif
+
+    // data 开头连续的 ASCII 字节数；跟随 string_simd 当前选择的指令集
+    inline std::size_t asciiRun(const unsigned char* data, std::size_t size)
+    {
+#if STRING_SIMD_X86
+        switch (string_simd::activeIsa())
+        {
+        case string_simd::Isa::AVX2: return asciiRunAvx2(data, size);
+        case string_simd::Isa::SSSE3: return asciiRunSse2(data, size);
+        default: break;
+        }
+#endif
+        return asciiRunScalar(data, size);
+    }
+
+#if STRING_SIMD_X86
+    // AVX2 的整块校验 (Keiser & Lemire 的查表法，simdjson / simdutf 使用的算法)：
+    // 每个字节和它前面的 1~3 个字节一起决定是否合法。取前一个字节的高 4 位、低 4 位和当前字节的高 4 位，
+    // 各查一张 16 项的表 (pshufb)，每一位代表一类错误；三者按位与之后不为 0 就说明出错。
+    // 三、四字节序列的第 3、4 个字节另外用 "前 2 / 前 3 个字节是否为 3 / 4 字节首字节" 来检查。
+    // 整块都是 ASCII 时只需检查上一块末尾有没有未完成的序列。
+    namespace validate_avx2
+    {
+        constexpr std::uint8_t kTooShort {1 << 0};  // 首字节后面跟的不是续字节
+        constexpr std::uint8_t kTooLong {1 << 1};   // ASCII 后面跟续字节
+        constexpr std::uint8_t kOverlong3 {1 << 2}; // E0 80..9F
+        constexpr std::uint8_t kTooLarge {1 << 3};  // 大于 U+10FFFF
+        constexpr std::uint8_t kSurrogate {1 << 4}; // ED A0..BF
+        constexpr std::uint8_t kOverlong2 {1 << 5}; // C0 / C1
+        constexpr std::uint8_t kTooLarge1000 {1 << 6};
+        constexpr std::uint8_t kOverlong4 {1 << 6}; // F0 80..8F
+        constexpr std::uint8_t kTwoConts {1 << 7};  // 续字节后面跟续字节 (由长度检查抵消合法的情况)
+        constexpr std::uint8_t kCarry {kTooShort | kTooLong | kTwoConts};
+
+        // 把 prev 的末尾 N 个字节移到 input 的前面 (跨越两个 128 位半边)
+        template <int N>
+        __attribute__((target("avx2"))) inline __m256i previous(__m256i input, __m256i prev)
+        {
+            return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - N);
+        }
+
+        __attribute__((target("avx2"))) inline __m256i lookup(__m256i table, __m256i nibbles)
+        {
+            return _mm256_shuffle_epi8(table, nibbles);
+        }
+
+        __attribute__((target("avx2"))) inline __m256i table16(std::uint8_t t0, std::uint8_t t1, std::uint8_t t2, std::uint8_t t3,
+                                                               std::uint8_t t4, std::uint8_t t5, std::uint8_t t6, std::uint8_t t7,
+                                                               std::uint8_t t8, std::uint8_t t9, std::uint8_t t10, std::uint8_t t11,
+                                                               std::uint8_t t12, std::uint8_t t13, std::uint8_t t14, std::uint8_t t15)
+        {
+            return _mm256_setr_epi8(static_cast<char>(t0), static_cast<char>(t1), static_cast<char>(t2), static_cast<char>(t3),
+                                    static_cast<char>(t4), static_cast<char>(t5), static_cast<char>(t6), static_cast<char>(t7),
+                                    static_cast<char>(t8), static_cast<char>(t9), static_cast<char>(t10), static_cast<char>(t11),
+                                    static_cast<char>(t12), static_cast<char>(t13), static_cast<char>(t14), static_cast<char>(t15),
+                                    static_cast<char>(t0), static_cast<char>(t1), static_cast<char>(t2), static_cast<char>(t3),
+                                    static_cast<char>(t4), static_cast<char>(t5), static_cast<char>(t6), static_cast<char>(t7),
+                                    static_cast<char>(t8), static_cast<char>(t9), static_cast<char>(t10), static_cast<char>(t11),
+                                    static_cast<char>(t12), static_cast<char>(t13), static_cast<char>(t14), static_cast<char>(t15));
+        }
+
+        __attribute__((target("avx2"))) inline __m256i blockErrors(__m256i input, __m256i prevInput)
+        {
+            const __m256i lowNibble {_mm256_set1_epi8(0x0F)};
+            const __m256i prev1 {previous<1>(input, prevInput)};
+            const __m256i byte1High {lookup(
+                table16(kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong,
+                        kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+                        kTooShort | kOverlong2, kTooShort, kTooShort | kOverlong3 | kSurrogate,
+                        kTooShort | kTooLarge | kTooLarge1000 | kOverlong4),
+                _mm256_and_si256(_mm256_srli_epi16(prev1, 4), lowNibble))};
+            const __m256i byte1Low {lookup(
+                table16(kCarry | kOverlong3 | kOverlong2 | kOverlong4, kCarry | kOverlong2, kCarry, kCarry,
+                        kCarry | kTooLarge, kCarry | kTooLarge | kTooLarge1000, kCarry | kTooLarge | kTooLarge1000,
+                        kCarry | kTooLarge | kTooLarge1000, kCarry | kTooLarge | kTooLarge1000,
+                        kCarry | kTooLarge | kTooLarge1000, kCarry | kTooLarge | kTooLarge1000,
+                        kCarry | kTooLarge | kTooLarge1000, kCarry | kTooLarge | kTooLarge1000,
+                        kCarry | kTooLarge | kTooLarge1000 | kSurrogate, kCarry | kTooLarge | kTooLarge1000,
+                        kCarry | kTooLarge | kTooLarge1000),
+                _mm256_and_si256(prev1, lowNibble))};
+            const __m256i byte2High {lookup(
+                table16(kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort,
+                        kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 | kOverlong4,
+                        kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+                        kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+                        kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+                        kTooShort, kTooShort, kTooShort, kTooShort),
+                _mm256_and_si256(_mm256_srli_epi16(input, 4), lowNibble))};
+            const __m256i special {_mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High)};
+
+            // 前 2 个字节是 3 / 4 字节首字节 (>= E0)，或前 3 个字节是 4 字节首字节 (>= F0) 时，当前字节必须是续字节
+            const __m256i prev2 {previous<2>(input, prevInput)};
+            const __m256i prev3 {previous<3>(input, prevInput)};
+            const __m256i isThird {_mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)))};
+            const __m256i isFourth {_mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)))};
+            const __m256i mustBeContinuation {
+                _mm256_and_si256(_mm256_or_si256(isThird, isFourth), _mm256_set1_epi8(static_cast<char>(0x80)))};
+            return _mm256_xor_si256(mustBeContinuation, special);
+        }
+
+        // 块末尾的序列是否没有写完：最后 3 个字节里有需要更多续字节的首字节
+        __attribute__((target("avx2"))) inline __m256i incomplete(__m256i input)
+        {
+            const __m256i maxValue {_mm256_setr_epi8(
+                -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1))};
+            return _mm256_subs_epu8(input, maxValue);
+        }
+
+        // 整个缓冲区是否合法；multiByte 返回是否含有非 ASCII 字节
+        __attribute__((target("avx2"))) inline bool validate(const unsigned char* data, std::size_t size, bool& multiByte)
+        {
+            __m256i error {_mm256_setzero_si256()};
+            __m256i prevInput {_mm256_setzero_si256()};
+            __m256i prevIncomplete {_mm256_setzero_si256()};
+            __m256i highBits {_mm256_setzero_si256()};
+            auto process = [&](__m256i input) __attribute__((target("avx2")))
+            {
+                if (_mm256_movemask_epi8(input) == 0)
+                {
+                    error = _mm256_or_si256(error, prevIncomplete);
+                }
+                else
+                {
+                    highBits = _mm256_or_si256(highBits, input);
+                    error = _mm256_or_si256(error, blockErrors(input, prevInput));
+                    prevIncomplete = incomplete(input);
+                }
+                prevInput = input;
+            };
+            std::size_t i {0};
+            for (; i + 32 <= size; i += 32)
+            {
+                process(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+            }
+            if (i < size)
+            {
+                // 末尾不足 32 字节的部分补 0 (补上的 ASCII 也能暴露末尾被截断的序列)
+                alignas(32) unsigned char tail[32] {};
+                std::memcpy(tail, data + i, size - i);
+                process(_mm256_load_si256(reinterpret_cast<const __m256i*>(tail)));
+            }
+            error = _mm256_or_si256(error, prevIncomplete);
+            multiByte = _mm256_movemask_epi8(highBits) != 0;
+            return _mm256_testz_si256(error, error) != 0;
+        }
+    }
+#endif
+
+    // 第一个不合法字节的位置；整个缓冲区合法时返回 size。
+    // multiByte 返回是否遇到过非 ASCII 字符 (纯 ASCII 的文本反转后不需要修复)
+    inline std::size_t findInvalid(const char* text, std::size_t size, bool& multiByte)
+    {
+        const auto* data {reinterpret_cast<const unsigned char*>(text)};
+#if STRING_SIMD_X86
+        // 合法的输入 (最常见的情况) 整块校验完就结束；只有出错时才逐个字符扫描，找出出错的位置
+        if (string_simd::activeIsa() == string_simd::Isa::AVX2 && validate_avx2::validate(data, size, multiByte))
+        {
+            return size;
+        }
+#endif
+        multiByte = false;
+        std::size_t i {0};
+        while (i < size)
+        {
+            i += asciiRun(data + i, size - i);
+            // 非 ASCII 的部分逐个解码，直到再次遇到 ASCII 字节才回到 SIMD 扫描
+            while (i < size && data[i] >= 0x80)
+            {
+                std::uint32_t codePoint;
+                const std::size_t length {decode(data + i, size - i, codePoint)};
+                if (length == 0)
+                {
+                    return i;
+                }
+                multiByte = true;
+                i += length;
+            }
+        }
+        return size;
+    }
+
+    inline std::size_t findInvalid(const char* text, std::size_t size)
+    {
+        bool multiByte;
+        return findInvalid(text, size, multiByte);
+    }
+
+    inline bool isValid(const char* text, std::size_t size)
+    {
+        return findInvalid(text, size) == size;
+    }
+
+    inline bool isValid(const std::string& text)
+    {
+        return isValid(text.data(), text.size());
+    }
+
+    // 附着在前一个字符上、不单独构成字素簇的字符
+    inline bool isGraphemeExtend(std::uint32_t cp)
+    {
+        return (cp >= 0x0300 && cp <= 0x036F)      // 组合附加符号
+            || (cp >= 0x1AB0 && cp <= 0x1AFF)      // 组合附加符号扩展
+            || (cp >= 0x1DC0 && cp <= 0x1DFF)      // 组合附加符号补充
+            || (cp >= 0x20D0 && cp <= 0x20FF)      // 符号用组合附加符号
+            || (cp >= 0xFE20 && cp <= 0xFE2F)      // 组合半符号
+            || (cp >= 0xFE00 && cp <= 0xFE0F)      // 变体选择符 (例如 U+FE0F 表情样式)
+            || (cp >= 0x1F3FB && cp <= 0x1F3FF)    // 表情肤色修饰符
+            || (cp >= 0xE0020 && cp <= 0xE007F)    // 标签字符 (地区旗帜)
+            || cp == 0x200D;                       // ZWJ
+    }
+
+    inline bool isRegionalIndicator(std::uint32_t cp)
+    {
+        return cp >= 0x1F1E6 && cp <= 0x1F1FF;
+    }
+}
+
+namespace utf8_detail
+{
+    // 校验并返回是否含有多字节字符
+    inline bool requireValid(const char* data, std::size_t size)
+    {
+        bool multiByte;
+        const std::size_t bad {utf8::findInvalid(data, size, multiByte)};
+        if (bad != size)
+        {
+            throw std::invalid_argument("Invalid UTF-8 at byte " + std::to_string(bad));
+        }
+        return multiByte;
+    }
+
+    // 整体按字节反转之后，每个多字节字符变成 "续字节... 首字节"，把这一段再反转回来
+    inline void restoreCodePoints(char* text, std::size_t size)
+    {
+        auto* data {reinterpret_cast<unsigned char*>(text)};
+        std::size_t i {0};
+        while (i < size)
+        {
+            i += utf8::asciiRun(data + i, size - i);
+            while (i < size && data[i] >= 0x80)
+            {
+                std::size_t lead {i};
+                while (utf8::isContinuation(data[lead]))
+                {
+                    ++lead;
+                }
+                // 最多 4 个字节：交换两端，4 字节时再交换中间两个
+                std::swap(data[i], data[lead]);
+                if (lead - i == 3)
+                {
+                    std::swap(data[i + 1], data[i + 2]);
+                }
+                i = lead + 1;
+            }
+        }
+    }
+
+    // 原文中由多个码点组成的字素簇 [offset, offset + length)
+    struct Cluster
+    {
+        std::size_t offset;
+        std::size_t length;
+    };
+
+    inline std::vector<Cluster> findMultiCodePointClusters(const char* text, std::size_t size)
+    {
+        const auto* data {reinterpret_cast<const unsigned char*>(text)};
+        std::vector<Cluster> clusters;
+        std::size_t clusterStart {0};
+        std::size_t codePoints {0};
+        bool afterZwj {false};
+        bool unpairedRegional {false};
+        auto close = [&clusters, &clusterStart, &codePoints](std::size_t end)
+        {
+            if (codePoints > 1)
+            {
+                clusters.push_back({clusterStart, end - clusterStart});
+            }
+            clusterStart = end;
+            codePoints = 0;
+        };
+
+        std::size_t i {0};
+        while (i < size)
+        {
+            const std::size_t run {utf8::asciiRun(data + i, size - i)};
+            if (run > 0)
+            {
+                // 一串 ASCII 中每个字符各自成簇；只有最后一个可能被后面的附加符号扩展
+                close(i);
+                clusterStart = i + run - 1;
+                codePoints = 1;
+                i += run;
+                afterZwj = false;
+                unpairedRegional = false;
+                continue;
+            }
+            std::uint32_t cp {0};
+            const std::size_t length {utf8::decode(data + i, size - i, cp)};
+            bool extends {utf8::isGraphemeExtend(cp) || afterZwj};
+            if (utf8::isRegionalIndicator(cp))
+            {
+                extends = extends || unpairedRegional;
+                unpairedRegional = !unpairedRegional;
+            }
+            else
+            {
+                unpairedRegional = false;
+            }
+            if (!extends)
+            {
+                close(i);
+            }
+            ++codePoints;
+            afterZwj = cp == 0x200D;
+            i += length;
+        }
+        close(size);
+        return clusters;
+    }
+}
+
+// 按字符 (或字素簇) 反转一段 UTF-8 文本。输入不合法时抛 std::invalid_argument，不修改内容
+inline void reverseUtf8(char* data, std::size_t size, ReverseUnit unit = ReverseUnit::CodePoint)
+{
+    if (data == nullptr || size < 2)
+    {
+        return;
+    }
+    const bool multiByte {utf8_detail::requireValid(data, size)};
+    if (!multiByte)
+    {
+        // 纯 ASCII：字节就是字符，也是字素簇
+        reverseString(data, size);
+        return;
+    }
+    std::vector<utf8_detail::Cluster> clusters;
+    if (unit == ReverseUnit::Grapheme)
+    {
+        clusters = utf8_detail::findMultiCodePointClusters(data, size);
+    }
+    reverseString(data, size);
+    utf8_detail::restoreCodePoints(data, size);
+    // 由多个码点组成的簇：原来的 [offset, offset + length) 现在位于 [size - offset - length, size - offset)，
+    // 其中的码点顺序被颠倒了；再按码点反转一次这一小段就恢复原样
+    for (const auto& cluster : clusters)
+    {
+        char* first {data + size - cluster.offset - cluster.length};
+        reverseString(first, cluster.length);
+        utf8_detail::restoreCodePoints(first, cluster.length);
+    }
+}
+
+inline void reverseUtf8(std::string& text, ReverseUnit unit = ReverseUnit::CodePoint)
+{
+    reverseUtf8(text.data(), text.size(), unit);
+}
@@ -0,0 +1,99 @@
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "Ex2_fixed_matrix.hpp"
+
+template <typename Func>
+double measureMs(Func f)
+{
+    auto start {std::chrono::steady_clock::now()};
+    f();
+    auto end {std::chrono::steady_clock::now()};
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <typename M>
+void printMatrix(const M& m)
+{
+    for (std::size_t i {0}; i < m.rows(); ++i)
+    {
+        for (std::size_t j {0}; j < m.cols(); ++j)
+        {
+            std::cout << m(i, j) << '\t';
+        }
+        std::cout << '\n';
+    }
+}
+
+// 编译期求值：旋转 90 度的矩阵连乘四次回到单位矩阵
+constexpr FixedMatrix<int, 2, 2> kRotate {0, -1, 1, 0};
+constexpr FixedMatrix<int, 2, 2> kIdentity {1, 0, 0, 1};
+static_assert(kRotate * kRotate * kRotate * kRotate == kIdentity, "rotation by 360 degrees must be identity");
+static_assert(sizeof(FixedMatrix<int, 8, 5>) == 8 * 5 * sizeof(int), "FixedMatrix stores its elements inline");
+
+int main()
+{
+    // 1. 练习中的 8x5：尺寸是类型的一部分，数据在栈上
+    FixedMatrix<int, 8, 5> m;
+    m.fill([](std::size_t i, std::size_t j) { return (i + 1) * (j + 1); });
+    std::cout << "FixedMatrix<int, 8, 5> (sizeof = " << sizeof(m) << "):\n";
+    printMatrix(m);
+    std::cout << "m.get<7, 4>() = " << m.get<7, 4>() << '\n';
+    // m.get<8, 0>();             // 编译错误：Index out of bounds
+    // multiply(m, m);            // 编译错误：8x5 * 8x5 的内维不一致
+
+    // 2. 与动态矩阵互相转换：8x5 * 5x8 = 8x8
+    const auto product {m * transpose(m)};
+    const Matrix<int> dynamicProduct {multiply(m.toMatrix(), transpose(m).toMatrix())};
+    std::cout << "\nm * m^T 与动态 Matrix 的结果"
+              << (FixedMatrix<int, 8, 8>::fromMatrix(dynamicProduct) == product ? "一致" : "不一致!") << '\n';
+    try
+    {
+        FixedMatrix<int, 4, 4>::fromMatrix(dynamicProduct);
+    }
+    catch (const std::invalid_argument& e)
+    {
+        std::cout << "把 8x8 的 Matrix 转换成 FixedMatrix<int, 4, 4>: " << e.what() << '\n';
+    }
+
+    // 3. 热循环中的大量 4x4 乘法：每个动态 Matrix 的结果都要 malloc 一次
+    const std::size_t count {1000000};
+    std::vector<FixedMatrix<int, 4, 4>> fixedInputs(64);
+    std::vector<Matrix<int>> dynamicInputs;
+    for (std::size_t t {0}; t < fixedInputs.size(); ++t)
+    {
+        fixedInputs[t].fill([t](std::size_t i, std::size_t j) { return static_cast<int>((i * 4 + j + t) % 5) - 2; });
+        dynamicInputs.push_back(fixedInputs[t].toMatrix());
+    }
+
+    long long fixedSum {0};
+    double fixedMs {measureMs(
+        [&]
+        {
+            FixedMatrix<int, 4, 4> acc;
+            for (std::size_t t {0}; t < count; ++t)
+            {
+                acc = fixedInputs[t % 64] * fixedInputs[(t + 1) % 64];
+                fixedSum += acc(t % 4, (t / 4) % 4);
+            }
+        })};
+
+    long long dynamicSum {0};
+    double dynamicMs {measureMs(
+        [&]
+        {
+            Matrix<int> acc(4, 4);
+            for (std::size_t t {0}; t < count; ++t)
+            {
+                acc = multiply(dynamicInputs[t % 64], dynamicInputs[(t + 1) % 64]);
+                dynamicSum += acc(t % 4, (t / 4) % 4);
+            }
+        })};
+
+    std::cout << "\n" << count << " 次 4x4 乘法:\n";
+    std::cout << "Matrix<int>               : " << dynamicMs << " ms (校验和 " << dynamicSum << ")\n";
+    std::cout << "FixedMatrix<int, 4, 4>    : " << fixedMs << " ms (校验和 " << fixedSum << ")\n";
+    std::cout << "加速比: " << dynamicMs / fixedMs << "x\n";
+    return 0;
+}
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <cstddef>          // std::size_t
+#include <initializer_list> // std::initializer_list
+#include <stdexcept>        // std::out_of_range, std::invalid_argument
+#include <utility>          // std::index_sequence, std::make_index_sequence
+
+#include "Ex2_matrix.hpp"
+
+// 编译期固定尺寸的矩阵：练习里的 rows {8}; cols {5}; 在编译时就已经知道，
+// 没有必要每次都在堆上分配。FixedMatrix 把 R * C 个元素直接存放在对象内部：
+// - 放在栈上或嵌入其它对象中，构造和销毁都不调用 malloc / free
+// - 尺寸是类型的一部分，4x4 和 4x5 是不同的类型，乘法的维度不匹配是编译错误而不是运行时异常
+// - 所有操作都是 constexpr，可以在编译期求值
+// - 小矩阵的乘法被完全展开，没有循环控制的开销
+// 和动态的 Matrix 之间通过 toMatrix / fromMatrix 互相转换。
+template <typename T, std::size_t R, std::size_t C>
+class FixedMatrix
+{
+    static_assert(R > 0 && C > 0, "FixedMatrix dimensions must be positive");
+
+private:
+    T data_[R * C] {};
+
+public:
+    using value_type = T;
+
+    // 所有元素值初始化 (对 int 来说就是 0)
+    constexpr FixedMatrix() = default;
+
+    // 按行主序给出全部 R * C 个元素：FixedMatrix<int, 2, 2> m {1, 2, 3, 4};
+    constexpr FixedMatrix(std::initializer_list<T> values)
+    {
+        if (values.size() != R * C)
+        {
+            throw std::invalid_argument("FixedMatrix initializer has the wrong number of elements");
+        }
+        std::size_t i {0};
+        for (const T& value : values)
+        {
+            data_[i++] = value;
+        }
+    }
+
+    static constexpr std::size_t rows() { return R; }
+    static constexpr std::size_t cols() { return C; }
+    static constexpr std::size_t size() { return R * C; }
+
+    constexpr T* data() { return data_; }
+    constexpr const T* data() const { return data_; }
+
+    constexpr T* rowPtr(std::size_t row) { return data_ + row * C; }
+    constexpr const T* rowPtr(std::size_t row) const { return data_ + row * C; }
+
+    // 不做边界检查的访问
+    constexpr T& operator()(std::size_t row, std::size_t col) { return data_[row * C + col]; }
+    constexpr const T& operator()(std::size_t row, std::size_t col) const { return data_[row * C + col]; }
+
+    // 带边界检查的访问
+    constexpr T& at(std::size_t row, std::size_t col)
+    {
+        if (row >= R || col >= C)
+        {
+            throw std::out_of_range("Index out of bounds");
+        }
+        return data_[row * C + col];
+    }
+
+    constexpr const T& at(std::size_t row, std::size_t col) const
+    {
+        if (row >= R || col >= C)
+        {
+            throw std::out_of_range("Index out of bounds");
+        }
+        return data_[row * C + col];
+    }
+
+    // 下标是常量时在编译期检查边界：m.get<7, 4>()
+    template <std::size_t Row, std::size_t Col>
+    constexpr T& get()
+    {
+        static_assert(Row < R && Col < C, "Index out of bounds");
+        return data_[Row * C + Col];
+    }
+
+    template <std::size_t Row, std::size_t Col>
+    constexpr const T& get() const
+    {
+        static_assert(Row < R && Col < C, "Index out of bounds");
+        return data_[Row * C + Col];
+    }
+
+    template <typename Func>
+    constexpr void fill(Func f)
+    {
+        for (std::size_t i {0}; i < R; ++i)
+        {
+            for (std::size_t j {0}; j < C; ++j)
+            {
+                data_[i * C + j] = static_cast<T>(f(i, j));
+            }
+        }
+    }
+
+    // 转换成动态矩阵 (一次堆分配)
+    template <typename Allocation = DefaultAllocation>
+    Matrix<T, Allocation> toMatrix() const
+    {
+        Matrix<T, Allocation> result(R, C);
+        for (std::size_t i {0}; i < R; ++i)
+        {
+            for (std::size_t j {0}; j < C; ++j)
+            {
+                result(i, j) = data_[i * C + j];
+            }
+        }
+        return result;
+    }
+
+    // 从动态矩阵构造，尺寸只能在运行时检查
+    template <typename A>
+    static FixedMatrix fromMatrix(const Matrix<T, A>& m)
+    {
+        if (m.rows() != R || m.cols() != C)
+        {
+            throw std::invalid_argument("Matrix dimensions do not match FixedMatrix");
+        }
+        FixedMatrix result;
+        for (std::size_t i {0}; i < R; ++i)
+        {
+            const T* row {m.rowPtr(i)};
+            for (std::size_t j {0}; j < C; ++j)
+            {
+                result.data_[i * C + j] = row[j];
+            }
+        }
+        return result;
+    }
+
+    friend constexpr bool operator==(const FixedMatrix& a, const FixedMatrix& b)
+    {
+        for (std::size_t i {0}; i < R * C; ++i)
+        {
+            if (!(a.data_[i] == b.data_[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend constexpr bool operator!=(const FixedMatrix& a, const FixedMatrix& b)
+    {
+        return !(a == b);
+    }
+};
+
+namespace fixed_matrix_detail
+{
+    // 乘法中 R * K * C 次乘加不超过这个数时完全展开，更大的矩阵展开后代码膨胀，改用循环
+    constexpr std::size_t kUnrollLimit {512};
+
+    // C(i, j) = sum_k A(i, k) * B(k, j)，用折叠表达式把 k 展开
+    template <std::size_t I, std::size_t J, typename T, std::size_t R, std::size_t K, std::size_t C, std::size_t... Ks>
+    constexpr T dot(const FixedMatrix<T, R, K>& a, const FixedMatrix<T, K, C>& b, std::index_sequence<Ks...>)
+    {
+        return ((a(I, Ks) * b(Ks, J)) + ...);
+    }
+
+    // 对结果的每个元素 (下标 Is = i * C + j) 展开
+    template <typename T, std::size_t R, std::size_t K, std::size_t C, std::size_t... Is>
+    constexpr FixedMatrix<T, R, C> multiplyUnrolled(const FixedMatrix<T, R, K>& a, const FixedMatrix<T, K, C>& b,
+                                                    std::index_sequence<Is...>)
+    {
+        FixedMatrix<T, R, C> result;
+        ((result.data()[Is] = dot<Is / C, Is % C>(a, b, std::make_index_sequence<K> {})), ...);
+        return result;
+    }
+
+    // 较大的矩阵：i-k-j 顺序的循环，循环次数是常量，编译器仍然可以部分展开并向量化
+    template <typename T, std::size_t R, std::size_t K, std::size_t C>
+    constexpr FixedMatrix<T, R, C> multiplyLoop(const FixedMatrix<T, R, K>& a, const FixedMatrix<T, K, C>& b)
+    {
+        FixedMatrix<T, R, C> result;
+        for (std::size_t i {0}; i < R; ++i)
+        {
+            for (std::size_t k {0}; k < K; ++k)
+            {
+                const T aik {a(i, k)};
+                for (std::size_t j {0}; j < C; ++j)
+                {
+                    result(i, j) += aik * b(k, j);
+                }
+            }
+        }
+        return result;
+    }
+}
+
+// (R x K) * (K x C) -> (R x C)，内维不一致时无法通过编译
+template <typename T, std::size_t R, std::size_t K, std::size_t C>
+constexpr FixedMatrix<T, R, C> multiply(const FixedMatrix<T, R, K>& a, const FixedMatrix<T, K, C>& b)
+{
+    if constexpr (R * K * C <= fixed_matrix_detail::kUnrollLimit)
+    {
+        return fixed_matrix_detail::multiplyUnrolled(a, b, std::make_index_sequence<R * C> {});
+    }
+    else
+    {
+        return fixed_matrix_detail::multiplyLoop(a, b);
+    }
+}
+
+template <typename T, std::size_t R, std::size_t K, std::size_t C>
+constexpr FixedMatrix<T, R, C> operator*(const FixedMatrix<T, R, K>& a, const FixedMatrix<T, K, C>& b)
+{
+    return multiply(a, b);
+}
+
+template <typename T, std::size_t R, std::size_t C>
+constexpr FixedMatrix<T, R, C> add(const FixedMatrix<T, R, C>& a, const FixedMatrix<T, R, C>& b)
+{
+    FixedMatrix<T, R, C> result;
+    for (std::size_t i {0}; i < R * C; ++i)
+    {
+        result.data()[i] = a.data()[i] + b.data()[i];
+    }
+    return result;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+constexpr FixedMatrix<T, R, C> operator+(const FixedMatrix<T, R, C>& a, const FixedMatrix<T, R, C>& b)
+{
+    return add(a, b);
+}
+
+template <typename T, std::size_t R, std::size_t C>
+constexpr FixedMatrix<T, R, C> operator-(const FixedMatrix<T, R, C>& a, const FixedMatrix<T, R, C>& b)
+{
+    FixedMatrix<T, R, C> result;
+    for (std::size_t i {0}; i < R * C; ++i)
+    {
+        result.data()[i] = a.data()[i] - b.data()[i];
+    }
+    return result;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+constexpr FixedMatrix<T, R, C> operator*(const FixedMatrix<T, R, C>& a, T factor)
+{
+    FixedMatrix<T, R, C> result;
+    for (std::size_t i {0}; i < R * C; ++i)
+    {
+        result.data()[i] = a.data()[i] * factor;
+    }
+    return result;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+constexpr FixedMatrix<T, R, C> operator*(T factor, const FixedMatrix<T, R, C>& a)
+{
+    return a * factor;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+constexpr FixedMatrix<T, C, R> transpose(const FixedMatrix<T, R, C>& a)
+{
+    FixedMatrix<T, C, R> result;
+    for (std::size_t i {0}; i < R; ++i)
+    {
+        for (std::size_t j {0}; j < C; ++j)
+        {
+            result(j, i) = a(i, j);
+        }
+    }
+    return result;
+}
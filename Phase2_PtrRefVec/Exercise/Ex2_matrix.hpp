@@ -0,0 +1,350 @@
+#pragma once
+
+#include <algorithm> // std::copy, std::fill_n, std::min
+#include <cstddef>   // std::size_t
+#include <memory>    // std::allocator, std::uninitialized_value_construct_n, std::destroy_n
+#include <stdexcept> // std::out_of_range, std::invalid_argument
+#include <utility>   // std::swap
+
+// 惰性表达式的基类，定义在 Ex2_matrix_expr.hpp 中
+template <typename E>
+struct MatrixExpr;
+
+// 默认的分配策略：和 new T[] 一样，只保证 alignof(T) 对齐，每行紧挨着存放 (stride == cols)。
+// 分配策略需要提供：
+//   stride<T>(cols)      每行实际占用的元素个数 (leading dimension)，>= cols
+//   allocate<T>(n)       分配能容纳 n 个 T 的原始内存
+//   deallocate<T>(p, n)  释放 allocate 得到的内存
+// 其它策略 (缓存行对齐、行填充、大页) 见 Ex2_matrix_alloc.hpp
+struct DefaultAllocation
+{
+    template <typename T>
+    static std::size_t stride(std::size_t cols) { return cols; }
+
+    template <typename T>
+    static T* allocate(std::size_t n) { return std::allocator<T>().allocate(n); }
+
+    template <typename T>
+    static void deallocate(T* p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+};
+
+// 方案四：把方案三 (扁平化一维数组) 封装成一个 RAII 的值类型
+// - 仍然只有一次分配 / 一次释放，数据按行主序 (row-major) 存放
+// - 构造函数负责分配，析构函数负责释放，不再需要手动调用 destroyMatrix_challenge
+// - 支持拷贝 (深拷贝) 和移动 (直接"偷走"指针，O(1))
+// - 第 i 行从 data() + i * stride() 开始；默认策略下 stride() == cols()，整块数据是连续的
+template <typename T, typename Allocation = DefaultAllocation>
+class Matrix
+{
+private:
+    std::size_t rows_;
+    std::size_t cols_;
+    std::size_t stride_;
+    T* data_;
+
+    std::size_t capacity() const { return rows_ * stride_; }
+
+    void release() noexcept
+    {
+        if (data_ != nullptr)
+        {
+            std::destroy_n(data_, capacity());
+            Allocation::template deallocate<T>(data_, capacity());
+        }
+    }
+
+public:
+    using value_type = T;
+
+    Matrix() : rows_{0}, cols_{0}, stride_{0}, data_{nullptr} {}
+
+    // 所有元素 (包括行尾的填充) 都被值初始化，对 int 来说就是 0
+    Matrix(std::size_t rows, std::size_t cols)
+        : rows_{rows}, cols_{cols}, stride_{Allocation::template stride<T>(cols)}, data_{nullptr}
+    {
+        if (capacity() != 0)
+        {
+            data_ = Allocation::template allocate<T>(capacity());
+            std::uninitialized_value_construct_n(data_, capacity());
+        }
+    }
+
+    Matrix(std::size_t rows, std::size_t cols, const T& value) : Matrix(rows, cols)
+    {
+        for (std::size_t i {0}; i < rows_; ++i)
+        {
+            std::fill_n(rowPtr(i), cols_, value);
+        }
+    }
+
+    ~Matrix()
+    {
+        release();
+    }
+
+    // 拷贝构造：深拷贝，两个对象各自拥有独立的数据块
+    Matrix(const Matrix& other) : Matrix(other.rows_, other.cols_)
+    {
+        std::copy(other.data_, other.data_ + other.capacity(), data_);
+    }
+
+    // 移动构造：接管 other 的数据块，并把 other 置为空矩阵
+    Matrix(Matrix&& other) noexcept
+        : rows_{other.rows_}, cols_{other.cols_}, stride_{other.stride_}, data_{other.data_}
+    {
+        other.rows_ = 0;
+        other.cols_ = 0;
+        other.stride_ = 0;
+        other.data_ = nullptr;
+    }
+
+    // 拷贝并交换 (copy-and-swap)：拷贝失败时 *this 保持不变 (强异常保证)
+    Matrix& operator=(const Matrix& other)
+    {
+        if (this != &other)
+        {
+            Matrix copy {other};
+            swap(copy);
+        }
+        return *this;
+    }
+
+    Matrix& operator=(Matrix&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            rows_ = other.rows_;
+            cols_ = other.cols_;
+            stride_ = other.stride_;
+            data_ = other.data_;
+            other.rows_ = 0;
+            other.cols_ = 0;
+            other.stride_ = 0;
+            other.data_ = nullptr;
+        }
+        return *this;
+    }
+
+    // 从惰性表达式 (例如 A + B * 2 - C) 构造：整个表达式在一次遍历中求值，
+    // 新分配的内存不可能与操作数重叠，所以直接写入 data_
+    template <typename E>
+    Matrix(const MatrixExpr<E>& expr) : Matrix(expr.rows(), expr.cols())
+    {
+        evalFrom(expr, false);
+    }
+
+    // 赋值时 *this 可能出现在右侧 (A = B + A)，所以按块先算到临时缓冲区再写回
+    template <typename E>
+    Matrix& operator=(const MatrixExpr<E>& expr)
+    {
+        if (rows_ != expr.rows() || cols_ != expr.cols())
+        {
+            Matrix result {expr};
+            swap(result);
+        }
+        else
+        {
+            evalFrom(expr, true);
+        }
+        return *this;
+    }
+
+    void swap(Matrix& other) noexcept
+    {
+        std::swap(rows_, other.rows_);
+        std::swap(cols_, other.cols_);
+        std::swap(stride_, other.stride_);
+        std::swap(data_, other.data_);
+    }
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    std::size_t stride() const { return stride_; }
+    std::size_t size() const { return rows_ * cols_; }
+    bool empty() const { return size() == 0; }
+
+    // 没有行填充时，rows * cols 个元素是一整块连续内存，可以当作一维数组处理
+    bool isContiguous() const { return stride_ == cols_; }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+
+    // 第 row 行的首地址，热循环里用它代替逐元素的下标计算
+    T* rowPtr(std::size_t row) { return data_ + row * stride_; }
+    const T* rowPtr(std::size_t row) const { return data_ + row * stride_; }
+
+    // 不做边界检查的访问，对应 test[i][j]
+    T& operator()(std::size_t row, std::size_t col) { return data_[row * stride_ + col]; }
+    const T& operator()(std::size_t row, std::size_t col) const { return data_[row * stride_ + col]; }
+
+    // 带边界检查的访问，对应方案三中的 getElement
+    T& at(std::size_t row, std::size_t col)
+    {
+        if (row >= rows_ || col >= cols_)
+        {
+            throw std::out_of_range("Index out of bounds");
+        }
+        return data_[row * stride_ + col];
+    }
+
+    const T& at(std::size_t row, std::size_t col) const
+    {
+        if (row >= rows_ || col >= cols_)
+        {
+            throw std::out_of_range("Index out of bounds");
+        }
+        return data_[row * stride_ + col];
+    }
+
+    // 按 f(i, j) 填充每个元素，例如 fill([](auto i, auto j) { return (i + 1) * (j + 1); })
+    template <typename Func>
+    void fill(Func f)
+    {
+        for (std::size_t i {0}; i < rows_; ++i)
+        {
+            T* row {rowPtr(i)};
+            for (std::size_t j {0}; j < cols_; ++j)
+            {
+                row[j] = static_cast<T>(f(i, j));
+            }
+        }
+    }
+
+private:
+    // 表达式按逻辑下标 (i * cols + j) 求值；有行填充时逐行写入
+    template <typename E>
+    void evalFrom(const MatrixExpr<E>& expr, bool mayAlias)
+    {
+        if (isContiguous())
+        {
+            expr.evalRangeTo(0, size(), data_, mayAlias);
+            return;
+        }
+        for (std::size_t i {0}; i < rows_; ++i)
+        {
+            expr.evalRangeTo(i * cols_, cols_, rowPtr(i), mayAlias);
+        }
+    }
+};
+
+template <typename T, typename A>
+void swap(Matrix<T, A>& a, Matrix<T, A>& b) noexcept
+{
+    a.swap(b);
+}
+
+// 分块 (tiling) 的尺寸：
+// - 乘法中一块 B (kMultiplyTileK x kMultiplyTileJ 个 double = 256 KB) 大致装进 L2，
+//   C 的一行分块 (kMultiplyTileJ 个元素) 和 A 的一小段常驻 L1
+// - 转置按 kTransposeTile x kTransposeTile 的小方块进行，读写两侧都只触及少量缓存行
+namespace MatrixTiling
+{
+    constexpr std::size_t kMultiplyTileI {64};
+    constexpr std::size_t kMultiplyTileK {128};
+    constexpr std::size_t kMultiplyTileJ {256};
+    constexpr std::size_t kTransposeTile {32};
+}
+
+// 逐元素相加：C = A + B
+template <typename T, typename A>
+Matrix<T, A> add(const Matrix<T, A>& a, const Matrix<T, A>& b)
+{
+    if (a.rows() != b.rows() || a.cols() != b.cols())
+    {
+        throw std::invalid_argument("Matrix dimensions do not match for add");
+    }
+    Matrix<T, A> result(a.rows(), a.cols());
+    // 逐行处理 (兼容行填充)，每行内部是连续访问，编译器可以自动向量化
+    for (std::size_t i {0}; i < a.rows(); ++i)
+    {
+        const T* pa {a.rowPtr(i)};
+        const T* pb {b.rowPtr(i)};
+        T* pc {result.rowPtr(i)};
+        for (std::size_t j {0}; j < a.cols(); ++j)
+        {
+            pc[j] = pa[j] + pb[j];
+        }
+    }
+    return result;
+}
+
+// 分块转置：朴素的双重循环在写入侧每个元素都跨越 rows 个元素，几乎每次都缓存未命中；
+// 按小方块处理时，一个方块内读到的缓存行在写完之前都还留在 L1 中
+template <typename T, typename A>
+Matrix<T, A> transpose(const Matrix<T, A>& a)
+{
+    using MatrixTiling::kTransposeTile;
+    Matrix<T, A> result(a.cols(), a.rows());
+    for (std::size_t ii {0}; ii < a.rows(); ii += kTransposeTile)
+    {
+        const std::size_t iEnd {std::min(ii + kTransposeTile, a.rows())};
+        for (std::size_t jj {0}; jj < a.cols(); jj += kTransposeTile)
+        {
+            const std::size_t jEnd {std::min(jj + kTransposeTile, a.cols())};
+            for (std::size_t i {ii}; i < iEnd; ++i)
+            {
+                const T* src {a.rowPtr(i)};
+                for (std::size_t j {jj}; j < jEnd; ++j)
+                {
+                    result(j, i) = src[j];
+                }
+            }
+        }
+    }
+    return result;
+}
+
+// 计算 C 的 [rowBegin, rowEnd) 行：C += A * B。
+// 循环顺序为 i-k-j，最内层对 B 和 C 都是连续访问，可以被自动向量化；
+// 再在三个维度上分块，让 B 的一个分块在被重复使用期间一直留在缓存里。
+template <typename T, typename A>
+void multiplyRows(const Matrix<T, A>& a, const Matrix<T, A>& b, Matrix<T, A>& c,
+                  std::size_t rowBegin, std::size_t rowEnd)
+{
+    using MatrixTiling::kMultiplyTileI;
+    using MatrixTiling::kMultiplyTileK;
+    using MatrixTiling::kMultiplyTileJ;
+    const std::size_t inner {a.cols()};
+    const std::size_t cols {b.cols()};
+
+    for (std::size_t kk {0}; kk < inner; kk += kMultiplyTileK)
+    {
+        const std::size_t kEnd {std::min(kk + kMultiplyTileK, inner)};
+        for (std::size_t jj {0}; jj < cols; jj += kMultiplyTileJ)
+        {
+            const std::size_t jEnd {std::min(jj + kMultiplyTileJ, cols)};
+            for (std::size_t ii {rowBegin}; ii < rowEnd; ii += kMultiplyTileI)
+            {
+                const std::size_t iEnd {std::min(ii + kMultiplyTileI, rowEnd)};
+                for (std::size_t i {ii}; i < iEnd; ++i)
+                {
+                    const T* rowA {a.rowPtr(i)};
+                    T* rowC {c.rowPtr(i)};
+                    for (std::size_t k {kk}; k < kEnd; ++k)
+                    {
+                        const T aik {rowA[k]};
+                        const T* rowB {b.rowPtr(k)};
+                        for (std::size_t j {jj}; j < jEnd; ++j)
+                        {
+                            rowC[j] += aik * rowB[j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// 分块矩阵乘法：C = A * B
+template <typename T, typename A>
+Matrix<T, A> multiply(const Matrix<T, A>& a, const Matrix<T, A>& b)
+{
+    if (a.cols() != b.rows())
+    {
+        throw std::invalid_argument("Matrix dimensions do not match for multiply");
+    }
+    Matrix<T, A> result(a.rows(), b.cols());
+    multiplyRows(a, b, result, 0, a.rows());
+    return result;
+}
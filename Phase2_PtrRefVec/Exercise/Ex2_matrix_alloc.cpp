@@ -0,0 +1,97 @@
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+#include "Ex2_matrix_alloc.hpp"
+#include "Ex2_matrix_parallel.hpp"
+
+template <typename Func>
+double measureMs(Func f)
+{
+    auto start {std::chrono::steady_clock::now()};
+    f();
+    auto end {std::chrono::steady_clock::now()};
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <typename M>
+void describe(const char* name, const M& m)
+{
+    const auto address {reinterpret_cast<std::uintptr_t>(m.data())};
+    std::cout << std::left << std::setw(36) << name << std::right << ": " << m.rows() << 'x' << m.cols() << ", stride " << m.stride()
+              << ", 起始地址 % 64 = " << address % 64 << ", 每行字节数 " << m.stride() * sizeof(typename M::value_type)
+              << '\n';
+}
+
+// 列主序求和：同一列的相邻元素相距 stride 个元素
+template <typename M>
+long long sumColumnMajor(const M& m)
+{
+    long long total {0};
+    for (std::size_t j {0}; j < m.cols(); ++j)
+    {
+        for (std::size_t i {0}; i < m.rows(); ++i)
+        {
+            total += m(i, j);
+        }
+    }
+    return total;
+}
+
+int main()
+{
+    // 1. 练习中的 8x5：默认策略 vs 缓存行对齐 + 行填充
+    Matrix<int> plain(8, 5);
+    Matrix<int, CacheAlignedAllocation> aligned(8, 5);
+    describe("DefaultAllocation", plain);
+    describe("CacheAlignedAllocation", aligned);
+
+    // 2. cols == 1024：默认布局下每行 4096 字节，同一列的元素全部映射到同一个 L1 组
+    const std::size_t n {1024};
+    Matrix<int> square(n, n);
+    Matrix<int, CacheAlignedAllocation> padded(n, n);
+    Matrix<int, BasicCacheAlignedAllocation<false>> alignedOnly(n, n);
+    auto init = [](std::size_t i, std::size_t j) { return static_cast<int>((i * 7 + j) % 100); };
+    square.fill(init);
+    padded.fill(init);
+    alignedOnly.fill(init);
+    std::cout << '\n';
+    describe("DefaultAllocation", square);
+    describe("BasicCacheAlignedAllocation<false>", alignedOnly);
+    describe("CacheAlignedAllocation", padded);
+
+    long long s1 {0};
+    long long s2 {0};
+    long long s3 {0};
+    double plainMs {measureMs([&] { for (int k {0}; k < 5; ++k) s1 += sumColumnMajor(square); })};
+    double alignedOnlyMs {measureMs([&] { for (int k {0}; k < 5; ++k) s2 += sumColumnMajor(alignedOnly); })};
+    double paddedMs {measureMs([&] { for (int k {0}; k < 5; ++k) s3 += sumColumnMajor(padded); })};
+    std::cout << "列主序遍历 x5: 默认 " << plainMs << " ms, 仅对齐 " << alignedOnlyMs << " ms, 对齐+填充 "
+              << paddedMs << " ms, 结果" << (s1 == s2 && s1 == s3 ? "一致" : "不一致") << '\n';
+
+    // 3. 多线程逐行写入：cols == 5 时默认布局的多行挤在同一个缓存行里，看起来会有伪共享，
+    //    但 parallel::fill 每次分给线程的是连续的一段行 (这里每段 256 行 = 5 KB)，只有两段交界处的
+    //    那一个缓存行可能被两个线程同时写，伪共享可以忽略。
+    //    每行填充到 64 字节反而让要写的内存从 20 MB 变成 64 MB (还要多出同样比例的缺页)，明显更慢。
+    //    行填充只在每行本身已经有好几个缓存行 (填充占比很小)，或者线程交替处理相邻的行时才划算
+    const std::size_t tallRows {1 << 20};
+    Matrix<int> tall(tallRows, 5);
+    Matrix<int, CacheAlignedAllocation> tallAligned(tallRows, 5);
+    auto rowWriter = [](std::size_t i, std::size_t j) { return static_cast<int>(i + j); };
+    auto megabytes = [](const auto& m) { return m.rows() * m.stride() * sizeof(int) / (1024 * 1024); };
+    ThreadPool pool;
+    double tallMs {measureMs([&] { parallel::fill(tall, rowWriter, pool); })};
+    double tallAlignedMs {measureMs([&] { parallel::fill(tallAligned, rowWriter, pool); })};
+    std::cout << "\n" << pool.threadCount() << " 个线程并行填充 " << tallRows << "x5: 默认 " << tallMs << " ms ("
+              << megabytes(tall) << " MB), 每行独占缓存行 " << tallAlignedMs << " ms (" << megabytes(tallAligned)
+              << " MB)\n";
+
+    // 4. 大缓冲区使用透明大页
+    Matrix<int, HugePageAllocation> huge(1024, 1024);
+    const auto hugeAddress {reinterpret_cast<std::uintptr_t>(huge.data())};
+    std::cout << "\nHugePageAllocation 1024x1024 (4 MB): stride " << huge.stride() << ", 起始地址按 2 MB 对齐: "
+              << (hugeAddress % HugePageAllocation::kHugePageSize == 0 ? "是" : "否") << '\n';
+    Matrix<int, HugePageAllocation> product {multiply(huge, huge)};
+    std::cout << "大页矩阵也能直接参与分块乘法: " << product.rows() << 'x' << product.cols() << '\n';
+}
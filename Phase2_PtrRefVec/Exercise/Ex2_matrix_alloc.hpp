@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uintptr_t
+#include <new>     // operator new(std::size_t, std::align_val_t), std::bad_alloc
+
+#if defined(__linux__)
+#include <sys/mman.h> // mmap, munmap, madvise
+#endif
+
+#include "Ex2_matrix.hpp"
+
+// Matrix 的分配策略 (第二个模板参数)，用来解决 new int[] 带来的三个问题：
+//
+// 1. 对齐：new 只保证 alignof(int) == 4 字节对齐，一行可能横跨缓存行边界开始。
+//    这里的起始地址按 64 字节 (一个缓存行) 对齐。
+// 2. 行填充：每行的长度 (stride，也叫 leading dimension) 向上取整到 64 字节的整数倍，
+//    于是每一行都从一个新的缓存行开始——不同线程写不同的行时，永远不会写到同一个缓存行上
+//    (不会出现伪共享 false sharing)。代价是很短的行会被放大好几倍 (5 个 int 的行变成 64 字节)，
+//    而 parallel:: 里的函数本来就按连续的一段行分给线程，只有段的交界处可能共享缓存行，
+//    所以短行的矩阵不要为了避免伪共享而用它 (见 Ex2_matrix_alloc.cpp 第 3 部分的对比)。
+// 3. 缓存组冲突 (cache-set aliasing)：L1 按地址的第 6~11 位选组，如果行长恰好是
+//    512 字节的整数倍 (例如 cols == 1024 或 4096 个 int)，同一列的元素会落在极少数几个组里，
+//    列方向遍历时互相驱逐。这种情况下再多填充一个缓存行，把各行错开。
+//
+// 用法：Matrix<int, CacheAlignedAllocation> m(rows, cols);
+// 注意：有填充时 data() 不再是 rows * cols 个连续元素，要按 rowPtr(i) / stride() 逐行访问。
+namespace matrix_alloc_detail
+{
+    constexpr std::size_t kCacheLine {64};
+    constexpr std::size_t kAliasingPeriod {512};
+
+    template <typename T, bool AvoidAliasing>
+    std::size_t paddedStride(std::size_t cols)
+    {
+        // 元素大小不能整除缓存行时无法按元素个数对齐，保持原样
+        if (kCacheLine % sizeof(T) != 0 || cols == 0)
+        {
+            return cols;
+        }
+        constexpr std::size_t perLine {kCacheLine / sizeof(T)};
+        std::size_t stride {(cols + perLine - 1) / perLine * perLine};
+        if (AvoidAliasing && (stride * sizeof(T)) % kAliasingPeriod == 0)
+        {
+            stride += perLine;
+        }
+        return stride;
+    }
+
+    inline void* alignedAllocate(std::size_t bytes)
+    {
+        return ::operator new(bytes, std::align_val_t {kCacheLine});
+    }
+
+    inline void alignedDeallocate(void* p)
+    {
+        ::operator delete(p, std::align_val_t {kCacheLine});
+    }
+}
+
+// 64 字节对齐 + 每行填充到整缓存行；AvoidAliasing 为 true 时再避开 512 字节整数倍的行长
+template <bool AvoidAliasing = true>
+struct BasicCacheAlignedAllocation
+{
+    template <typename T>
+    static std::size_t stride(std::size_t cols)
+    {
+        return matrix_alloc_detail::paddedStride<T, AvoidAliasing>(cols);
+    }
+
+    template <typename T>
+    static T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(matrix_alloc_detail::alignedAllocate(n * sizeof(T)));
+    }
+
+    template <typename T>
+    static void deallocate(T* p, std::size_t /*n*/)
+    {
+        matrix_alloc_detail::alignedDeallocate(p);
+    }
+};
+
+using CacheAlignedAllocation = BasicCacheAlignedAllocation<true>;
+
+// 在 CacheAlignedAllocation 的基础上，大于 2 MB 的缓冲区直接向内核 mmap，
+// 并用 MADV_HUGEPAGE 请求透明大页 (THP)：一个 2 MB 大页只占一个 TLB 项，
+// 遍历几个 GB 的矩阵时 TLB 未命中大幅减少。小缓冲区仍走普通的对齐分配。
+// 非 Linux 平台上退化为 CacheAlignedAllocation。
+struct HugePageAllocation
+{
+    static constexpr std::size_t kHugePageSize {2 * 1024 * 1024};
+
+    template <typename T>
+    static std::size_t stride(std::size_t cols)
+    {
+        return matrix_alloc_detail::paddedStride<T, true>(cols);
+    }
+
+    static std::size_t roundUp(std::size_t bytes)
+    {
+        return (bytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+    }
+
+    template <typename T>
+    static T* allocate(std::size_t n)
+    {
+#if defined(__linux__)
+        const std::size_t bytes {n * sizeof(T)};
+        if (bytes >= kHugePageSize)
+        {
+            // 多映射一个大页的长度，再把起始地址对齐到 2 MB 边界，内核才能用大页来映射
+            const std::size_t length {roundUp(bytes) + kHugePageSize};
+            void* raw {::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)};
+            if (raw == MAP_FAILED)
+            {
+                throw std::bad_alloc();
+            }
+            const auto rawAddress {reinterpret_cast<std::uintptr_t>(raw)};
+            const std::uintptr_t aligned {(rawAddress + kHugePageSize - 1) & ~(std::uintptr_t {kHugePageSize} - 1)};
+            // 把对齐前后多出来的部分还给内核
+            if (aligned > rawAddress)
+            {
+                ::munmap(raw, aligned - rawAddress);
+            }
+            const std::uintptr_t end {rawAddress + length};
+            const std::uintptr_t usedEnd {aligned + roundUp(bytes)};
+            if (end > usedEnd)
+            {
+                ::munmap(reinterpret_cast<void*>(usedEnd), end - usedEnd);
+            }
+            ::madvise(reinterpret_cast<void*>(aligned), roundUp(bytes), MADV_HUGEPAGE);
+            return reinterpret_cast<T*>(aligned);
+        }
+#endif
+        return static_cast<T*>(matrix_alloc_detail::alignedAllocate(n * sizeof(T)));
+    }
+
+    template <typename T>
+    static void deallocate(T* p, std::size_t n)
+    {
+#if defined(__linux__)
+        const std::size_t bytes {n * sizeof(T)};
+        if (bytes >= kHugePageSize)
+        {
+            ::munmap(p, roundUp(bytes));
+            return;
+        }
+#endif
+        matrix_alloc_detail::alignedDeallocate(p);
+    }
+};
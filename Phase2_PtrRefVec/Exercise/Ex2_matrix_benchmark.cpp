@@ -0,0 +1,376 @@
+// 对比三种矩阵内存布局的性能：
+//   方案一 jagged  : int**，每行单独 new (Ex2_matrix_operations.cpp)
+//   方案二 rowptr  : int**，行指针指向同一块连续内存 (Ex2_matrix_continous_operations.cpp)
+//   方案三 flat    : int*，一维数组 + i * cols + j (Ex2_matrix_flat_operations.cpp)
+//
+// 每种布局、每个尺寸测量五项：分配 + 释放 (方案三的 create 包括填充)、填充、行主序遍历、列主序遍历、随机访问，
+// 输出 ns/元素、分配次数、GB/s (只分配 + 释放不读写数据，没有 GB/s)，既打印成表格，也写成 JSON 方便跟踪性能回退。
+//
+// 用法: ./Ex2_matrix_benchmark [--max 边长上限] [--json 输出文件]
+// 编译: g++ -std=c++17 -O2 Ex2_matrix_benchmark.cpp -o Ex2_matrix_benchmark
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <string>
+#include <vector>
+
+// ---------------- 统计堆分配次数：替换全局 operator new / delete ----------------
+static std::size_t g_allocationCount {0};
+
+void* operator new(std::size_t size)
+{
+    ++g_allocationCount;
+    if (void* p {std::malloc(size == 0 ? 1 : size)})
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// ---------------- 三种布局 (逐字照抄各练习文件中的 create / destroy，修改练习时要同步修改这里) ----------------
+// 三个练习文件各自带 main，函数同名，没法直接 #include 进来，所以照抄；
+// 每种布局写成一个只含静态函数的 struct，方便作为模板参数传给 benchmarkLayout。
+// 方案三的 create 会顺带填充整个矩阵，所以它的第一项是 "alloc+fill"；
+// 三种布局都另外单独测一次填充 ("fill")，方案一、二的 alloc + fill 才能与方案三的 alloc+fill 对比。
+struct jagged
+{
+    using Handle = int**;
+    static constexpr bool kCreateFills {false};
+
+    // Ex2_matrix_operations.cpp
+    static int** createMatrix_challenge(int rows, int cols)
+    {
+        int** matrix {new int*[rows]};
+        for (int i {0}; i<rows; ++i)
+        {
+            matrix[i] = new int[cols];
+        }
+        return matrix;
+    }
+
+    static void destroyMatrix_challenge(int** matrix, int rows)
+    {
+        if (matrix == nullptr)
+        {
+            return;
+        }
+        for (int i {0}; i<rows; ++i)
+        {
+            delete[] matrix[i];
+            matrix[i] = nullptr;
+        }
+        delete[] matrix;
+    }
+
+    static int& at(int** m, int /*cols*/, int i, int j) { return m[i][j]; }
+};
+
+struct rowptr
+{
+    using Handle = int**;
+    static constexpr bool kCreateFills {false};
+
+    // Ex2_matrix_continous_operations.cpp
+    static int** createMatrix_challenge(int rows, int cols)
+    {
+        int* dataBlock {new int[rows * cols]};
+        int** matrix {new int*[rows]};
+        for (int i {0}; i<rows; ++i)
+        {
+            matrix[i] = &dataBlock[i*cols];
+        }
+        return matrix;
+    }
+
+    static void destroyMatrix_challenge(int** matrix, int rows)
+    {
+        delete[] matrix[0];
+        for (int i {0}; i<rows; ++i)
+        {
+            matrix[i] = nullptr;
+        }
+        delete[] matrix;
+    }
+
+    static int& at(int** m, int /*cols*/, int i, int j) { return m[i][j]; }
+};
+
+struct flat
+{
+    using Handle = int*;
+    static constexpr bool kCreateFills {true};
+
+    // Ex2_matrix_flat_operations.cpp
+    static int* createMatrix_challenge(int rows, int cols)
+    {
+        int* dataBlock {new int[rows * cols]};
+        for (int i {0}; i<rows; ++i)
+        {
+            for (int j {0}; j<cols; ++j)
+            {
+                dataBlock[i * cols + j] = (i + 1) * (j + 1);
+            }
+        }
+        return dataBlock;
+    }
+
+    static void destroyMatrix_challenge(int* matrix, int /*rows*/)
+    {
+        if (matrix == nullptr)
+        {
+            return;
+        }
+        delete[] matrix;
+    }
+
+    static int& at(int* m, int cols, int i, int j) { return m[static_cast<std::size_t>(i) * cols + j]; }
+};
+
+// ---------------- 计时工具 ----------------
+struct Result
+{
+    std::string layout;
+    int rows;
+    int cols;
+    std::string test;
+    double nsPerElement;
+    std::size_t allocations;
+    std::optional<double> gbPerSecond; // 只分配 + 释放不读写数据，没有吞吐量
+};
+
+// 防止编译器把只读不用的遍历整个优化掉
+static volatile std::int64_t g_sink {0};
+
+// 至少重复 minRepeats 次、累计至少 50 ms，取最快的一次
+template <typename Func>
+double bestSeconds(Func f, int minRepeats = 3)
+{
+    using Clock = std::chrono::steady_clock;
+    double best {1e300};
+    double total {0.0};
+    for (int rep {0}; rep < minRepeats || total < 0.05; ++rep)
+    {
+        auto start {Clock::now()};
+        f();
+        double seconds {std::chrono::duration<double>(Clock::now() - start).count()};
+        best = std::min(best, seconds);
+        total += seconds;
+    }
+    return best;
+}
+
+// 简单的 xorshift 随机数，生成随机访问用的坐标
+struct XorShift
+{
+    std::uint64_t state {0x9E3779B97F4A7C15ull};
+    std::uint64_t next()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+template <typename Layout>
+void benchmarkLayout(const char* name, int rows, int cols, std::vector<Result>& results)
+{
+    using Handle = typename Layout::Handle;
+    const double elements {static_cast<double>(rows) * cols};
+    const double bytes {elements * sizeof(int)};
+
+    // 1. 分配 + 释放 (方案三的 create 还包括填充)
+    std::size_t allocations {0};
+    double allocSeconds {bestSeconds([&] {
+        std::size_t before {g_allocationCount};
+        Handle m {Layout::createMatrix_challenge(rows, cols)};
+        allocations = g_allocationCount - before;
+        Layout::destroyMatrix_challenge(m, rows);
+    })};
+    results.push_back({name, rows, cols, Layout::kCreateFills ? "alloc+fill" : "alloc", allocSeconds * 1e9 / elements,
+                       allocations, Layout::kCreateFills ? std::optional<double> {bytes / allocSeconds / 1e9}
+                                                         : std::nullopt});
+
+    // 填充：与练习中 main (方案三是 create) 里的循环相同，单独计时
+    Handle m {Layout::createMatrix_challenge(rows, cols)};
+    double fillSeconds {bestSeconds([&] {
+        for (int i {0}; i < rows; ++i)
+        {
+            for (int j {0}; j < cols; ++j)
+            {
+                Layout::at(m, cols, i, j) = (i + 1) * (j + 1);
+            }
+        }
+    })};
+    results.push_back({name, rows, cols, "fill", fillSeconds * 1e9 / elements, 0, bytes / fillSeconds / 1e9});
+
+    // 2. 行主序遍历：与内存布局一致，顺序读取
+    double rowSeconds {bestSeconds([&] {
+        std::int64_t sum {0};
+        for (int i {0}; i < rows; ++i)
+        {
+            for (int j {0}; j < cols; ++j)
+            {
+                sum += Layout::at(m, cols, i, j);
+            }
+        }
+        g_sink = g_sink + sum;
+    })};
+    results.push_back({name, rows, cols, "row-major", rowSeconds * 1e9 / elements, 0, bytes / rowSeconds / 1e9});
+
+    // 3. 列主序遍历：每一步都跨越一整行
+    double colSeconds {bestSeconds([&] {
+        std::int64_t sum {0};
+        for (int j {0}; j < cols; ++j)
+        {
+            for (int i {0}; i < rows; ++i)
+            {
+                sum += Layout::at(m, cols, i, j);
+            }
+        }
+        g_sink = g_sink + sum;
+    })};
+    results.push_back({name, rows, cols, "col-major", colSeconds * 1e9 / elements, 0, bytes / colSeconds / 1e9});
+
+    // 4. 随机访问：坐标预先生成，不计入计时
+    const std::size_t accesses {std::min<std::size_t>(static_cast<std::size_t>(elements), 1u << 22)};
+    std::vector<std::uint32_t> coords(accesses * 2);
+    XorShift rng;
+    for (std::size_t k {0}; k < accesses; ++k)
+    {
+        coords[2 * k] = static_cast<std::uint32_t>(rng.next() % rows);
+        coords[2 * k + 1] = static_cast<std::uint32_t>(rng.next() % cols);
+    }
+    double randomSeconds {bestSeconds([&] {
+        std::int64_t sum {0};
+        for (std::size_t k {0}; k < accesses; ++k)
+        {
+            sum += Layout::at(m, cols, static_cast<int>(coords[2 * k]), static_cast<int>(coords[2 * k + 1]));
+        }
+        g_sink = g_sink + sum;
+    })};
+    results.push_back({name, rows, cols, "random", randomSeconds * 1e9 / accesses, 0,
+                       accesses * sizeof(int) / randomSeconds / 1e9});
+
+    Layout::destroyMatrix_challenge(m, rows);
+}
+
+// 只在函数内部使用 std::fixed 和 setprecision，结束时恢复 std::cout 原来的格式
+void printTable(const std::vector<Result>& results)
+{
+    const std::ios_base::fmtflags flags {std::cout.flags()};
+    const std::streamsize precision {std::cout.precision()};
+    std::cout << std::left << std::setw(8) << "layout" << std::setw(12) << "size" << std::setw(11) << "test"
+              << std::right << std::setw(12) << "ns/elem" << std::setw(10) << "allocs" << std::setw(10) << "GB/s"
+              << '\n';
+    std::cout << std::string(63, '-') << '\n';
+    for (const Result& r : results)
+    {
+        std::string size {std::to_string(r.rows) + 'x' + std::to_string(r.cols)};
+        std::cout << std::left << std::setw(8) << r.layout << std::setw(12) << size << std::setw(11) << r.test
+                  << std::right << std::fixed << std::setprecision(3) << std::setw(12) << r.nsPerElement
+                  << std::setw(10) << r.allocations << std::setprecision(2) << std::setw(10);
+        if (r.gbPerSecond)
+        {
+            std::cout << *r.gbPerSecond;
+        }
+        else
+        {
+            std::cout << '-';
+        }
+        std::cout << '\n';
+    }
+    std::cout.flags(flags);
+    std::cout.precision(precision);
+}
+
+// 无论 out 之前被设置成什么格式，数字都用 6 位有效数字的默认格式输出 (很小的 ns/元素也不会变成 0.00)
+void writeJson(std::ostream& out, const std::vector<Result>& results)
+{
+    const std::ios_base::fmtflags flags {out.flags()};
+    const std::streamsize precision {out.precision()};
+    out << std::defaultfloat << std::setprecision(6) << "[\n";
+    for (std::size_t k {0}; k < results.size(); ++k)
+    {
+        const Result& r {results[k]};
+        out << "  {\"layout\": \"" << r.layout << "\", \"rows\": " << r.rows << ", \"cols\": " << r.cols
+            << ", \"test\": \"" << r.test << "\", \"ns_per_element\": " << r.nsPerElement
+            << ", \"allocations\": " << r.allocations;
+        if (r.gbPerSecond)
+        {
+            out << ", \"gb_per_s\": " << *r.gbPerSecond;
+        }
+        out << '}' << (k + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "]\n";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+int main(int argc, char* argv[])
+{
+    int maxSize {8192};
+    const char* jsonPath {nullptr};
+    for (int i {1}; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--max") == 0 && i + 1 < argc)
+        {
+            maxSize = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+        {
+            jsonPath = argv[++i];
+        }
+        else
+        {
+            std::cerr << "用法: " << argv[0] << " [--max 边长上限] [--json 输出文件]\n";
+            return 1;
+        }
+    }
+
+    // 从练习中的 8x5 一直到 8192x8192
+    const int shapes[][2] {{8, 5}, {64, 64}, {256, 256}, {1024, 1024}, {4096, 4096}, {8192, 8192}};
+
+    std::vector<Result> results;
+    for (const auto& shape : shapes)
+    {
+        if (std::max(shape[0], shape[1]) > maxSize)
+        {
+            continue;
+        }
+        benchmarkLayout<jagged>("jagged", shape[0], shape[1], results);
+        benchmarkLayout<rowptr>("rowptr", shape[0], shape[1], results);
+        benchmarkLayout<flat>("flat", shape[0], shape[1], results);
+    }
+
+    printTable(results);
+
+    if (jsonPath != nullptr)
+    {
+        std::ofstream file {jsonPath};
+        writeJson(file, results);
+        std::cout << "\nJSON 已写入 " << jsonPath << '\n';
+    }
+    else
+    {
+        std::cout << '\n';
+        writeJson(std::cout, results);
+    }
+}
@@ -0,0 +1,92 @@
+#include <chrono>
+#include <iostream>
+#include <utility>
+
+#include "Ex2_matrix.hpp"
+
+// 朴素的 i-j-k 三重循环，用来和分块版本对照结果与耗时
+Matrix<double> multiplyNaive(const Matrix<double>& a, const Matrix<double>& b)
+{
+    Matrix<double> result(a.rows(), b.cols());
+    for (std::size_t i {0}; i < a.rows(); ++i)
+    {
+        for (std::size_t j {0}; j < b.cols(); ++j)
+        {
+            double sum {0.0};
+            for (std::size_t k {0}; k < a.cols(); ++k)
+            {
+                sum += a(i, k) * b(k, j); // b(k, j) 每次跨越一整行，缓存很不友好
+            }
+            result(i, j) = sum;
+        }
+    }
+    return result;
+}
+
+template <typename T>
+void printMatrix(const Matrix<T>& m)
+{
+    for (std::size_t i {0}; i < m.rows(); ++i)
+    {
+        for (std::size_t j {0}; j < m.cols(); ++j)
+        {
+            std::cout << m(i, j) << (j != m.cols() - 1 ? ' ' : '\n');
+        }
+    }
+}
+
+template <typename Func>
+double measureMs(Func f)
+{
+    auto start {std::chrono::steady_clock::now()};
+    f();
+    auto end {std::chrono::steady_clock::now()};
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main()
+{
+    // 与方案一 ~ 三相同的 8x5 矩阵，但不再需要 destroyMatrix_challenge
+    Matrix<int> test(8, 5);
+    test.fill([](std::size_t i, std::size_t j) { return (i + 1) * (j + 1); });
+    printMatrix(test);
+
+    std::cout << "\n转置后:\n";
+    printMatrix(transpose(test));
+
+    std::cout << "\n相加 (A + A):\n";
+    printMatrix(add(test, test));
+
+    // 移动语义：只转移指针，被移动的对象变成空矩阵
+    Matrix<int> moved {std::move(test)};
+    std::cout << "\n移动后: moved 为 " << moved.rows() << 'x' << moved.cols()
+              << ", test 为 " << test.rows() << 'x' << test.cols() << '\n';
+
+    // 较大的矩阵：对比朴素乘法与分块乘法
+    const std::size_t n {512};
+    Matrix<double> a(n, n);
+    Matrix<double> b(n, n);
+    a.fill([](std::size_t i, std::size_t j) { return static_cast<double>((i + j) % 7); });
+    b.fill([](std::size_t i, std::size_t j) { return static_cast<double>((i * j) % 5); });
+
+    Matrix<double> naive;
+    Matrix<double> blocked;
+    double naiveMs {measureMs([&] { naive = multiplyNaive(a, b); })};
+    double blockedMs {measureMs([&] { blocked = multiply(a, b); })};
+
+    bool same {true};
+    for (std::size_t i {0}; i < n && same; ++i)
+    {
+        for (std::size_t j {0}; j < n; ++j)
+        {
+            if (naive(i, j) != blocked(i, j))
+            {
+                same = false;
+                break;
+            }
+        }
+    }
+
+    std::cout << '\n' << n << 'x' << n << " 乘法: 朴素 " << naiveMs << " ms, 分块 " << blockedMs
+              << " ms, 结果" << (same ? "一致" : "不一致") << '\n';
+}
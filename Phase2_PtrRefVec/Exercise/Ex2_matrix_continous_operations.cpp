@@ -27,11 +27,13 @@ void destroyMatrix_challenge(int** matrix, int rows) {
     // 那么这里就应该 delete 几次。
     // 思考：销毁的顺序重要吗？应该先 delete 数据块，还是先 delete 行指针数组？
     // (提示：行指针数组里的指针指向数据块，如果先销毁数据块...)
+    // 注意：必须先通过 matrix[0] 释放数据块，再把行指针置空；
+    // 如果先置空，delete[] matrix[0] 就变成了 delete[] nullptr，数据块会泄漏
+    delete[] matrix[0]; // 删除数据块
     for (int i {0}; i<rows; ++i)
     {
         matrix[i] = nullptr; // 将行指针数组的每个指针置空
     }
-    delete[] matrix[0]; // 删除数据块
     delete[] matrix; // 删除行指针数组
 }
 
@@ -0,0 +1,74 @@
+#include <chrono>
+#include <iostream>
+
+#include "Ex2_matrix_expr.hpp"
+
+template <typename Func>
+double measureMs(Func f)
+{
+    auto start {std::chrono::steady_clock::now()};
+    f();
+    auto end {std::chrono::steady_clock::now()};
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <typename T>
+bool sameMatrix(const Matrix<T>& a, const Matrix<T>& b)
+{
+    if (a.rows() != b.rows() || a.cols() != b.cols())
+    {
+        return false;
+    }
+    for (std::size_t i {0}; i < a.size(); ++i)
+    {
+        if (a.data()[i] != b.data()[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    const std::size_t rows {4096};
+    const std::size_t cols {4096};
+    Matrix<int> a(rows, cols);
+    Matrix<int> b(rows, cols);
+    Matrix<int> c(rows, cols);
+    a.fill([](std::size_t i, std::size_t j) { return (i + 1) * (j + 1) % 1000; });
+    b.fill([](std::size_t i, std::size_t j) { return (i + j) % 17; });
+    c.fill([](std::size_t i, std::size_t j) { return (i * 3 + j) % 23; });
+
+    // 逐个运算：每一步都分配一个完整的临时矩阵，共 3 个临时矩阵、3 次完整的读写
+    Matrix<int> eager;
+    double eagerMs {measureMs([&] { eager = simd::sub(simd::add(a, simd::scale(b, 2)), c); })};
+
+    // 表达式模板：一次遍历，没有临时矩阵
+    Matrix<int> fused;
+    double fusedMs {measureMs([&] { fused = a + b * 2 - c; })};
+
+    std::cout << "A + B * 2 - C (" << rows << 'x' << cols << "): 逐个运算 " << eagerMs << " ms, 融合 "
+              << fusedMs << " ms, 结果" << (sameMatrix(eager, fused) ? "一致" : "不一致") << '\n';
+
+    // 别名：右侧引用了左侧的矩阵本身
+    Matrix<int> expected {simd::add(b, a)};
+    a = b + a;
+    std::cout << "A = B + A 的结果" << (sameMatrix(a, expected) ? "正确" : "错误") << '\n';
+
+    // 非 int 类型走普通循环
+    Matrix<double> x(3, 4, 1.5);
+    Matrix<double> y(3, 4, 2.0);
+    Matrix<double> z {hadamard(x, y) * 0.5 + x};
+    std::cout << "hadamard(x, y) * 0.5 + x = " << z(2, 3) << '\n';
+
+    // 形状不匹配在构建表达式时就会抛异常
+    try
+    {
+        Matrix<int> bad {a + Matrix<int>(2, 2)};
+    }
+    catch (const std::invalid_argument& e)
+    {
+        std::cout << "形状不匹配: " << e.what() << '\n';
+    }
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <algorithm>   // std::copy, std::min
+#include <cstddef>     // std::size_t
+#include <stdexcept>   // std::invalid_argument
+#include <type_traits> // std::is_same, std::is_base_of, std::enable_if_t, std::decay_t
+#include <utility>     // std::declval
+
+#include "Ex2_matrix.hpp"
+#include "Ex2_matrix_simd.hpp"
+
+// 表达式模板 (expression templates)：
+// 如果 operator+ 直接返回 Matrix，那么 A + B * 2 - C 会产生三个临时矩阵，
+// 每个都要 new 一次 rows * cols 的内存，并把数据完整地读写一遍。
+// 这里的运算符只返回一个轻量的"表达式对象"，记录要做什么运算；
+// 直到赋值给 Matrix 时才一次性求值，整个表达式只遍历内存一遍。
+//
+// 求值按块进行：每次取 kExprBlock 个元素，各节点把中间结果写进栈上的小缓冲区
+// (常驻 L1)，再调用 Ex2_matrix_simd.hpp 中的向量化内核。
+// 这样既没有整块的临时矩阵，又能用上 SIMD。
+//
+// 注意：表达式只保存对操作数的引用，不要用 auto 把表达式存下来后再让操作数失效。
+namespace matrix_expr_detail
+{
+    constexpr std::size_t kExprBlock {256};
+
+    // 对 int 使用运行时分发的 SIMD 内核，其它类型用普通循环 (由编译器自动向量化)
+    struct AddOp
+    {
+        template <typename T>
+        static void apply(const T* a, const T* b, T* out, std::size_t n)
+        {
+            if constexpr (std::is_same<T, int>::value)
+            {
+                simd::activeKernels().add(a, b, out, n);
+            }
+            else
+            {
+                for (std::size_t i {0}; i < n; ++i) out[i] = a[i] + b[i];
+            }
+        }
+    };
+
+    struct SubOp
+    {
+        template <typename T>
+        static void apply(const T* a, const T* b, T* out, std::size_t n)
+        {
+            if constexpr (std::is_same<T, int>::value)
+            {
+                simd::activeKernels().sub(a, b, out, n);
+            }
+            else
+            {
+                for (std::size_t i {0}; i < n; ++i) out[i] = a[i] - b[i];
+            }
+        }
+    };
+
+    struct MulOp
+    {
+        template <typename T>
+        static void apply(const T* a, const T* b, T* out, std::size_t n)
+        {
+            if constexpr (std::is_same<T, int>::value)
+            {
+                simd::activeKernels().mul(a, b, out, n);
+            }
+            else
+            {
+                for (std::size_t i {0}; i < n; ++i) out[i] = a[i] * b[i];
+            }
+        }
+    };
+
+    template <typename T>
+    void scale(const T* a, T s, T* out, std::size_t n)
+    {
+        if constexpr (std::is_same<T, int>::value)
+        {
+            simd::activeKernels().scale(a, s, out, n);
+        }
+        else
+        {
+            for (std::size_t i {0}; i < n; ++i) out[i] = a[i] * s;
+        }
+    }
+}
+
+// CRTP 基类：所有表达式节点都继承它，Matrix 通过它接收任意表达式。
+// 每个节点实现 evalBlock(offset, count, buffer)：计算第 [offset, offset + count) 个元素，
+// 返回指向结果的指针——可以是 buffer，也可以直接指向某个操作数的数据 (叶子节点无需拷贝)
+template <typename E>
+struct MatrixExpr
+{
+    const E& self() const { return static_cast<const E&>(*this); }
+
+    std::size_t rows() const { return self().rows(); }
+    std::size_t cols() const { return self().cols(); }
+
+    // 把逻辑下标 [first, first + total) 的元素依次写入 out。mayAlias 为 true 时 out 可能就是某个操作数，
+    // 需要先算到临时块中，整块算完后再写回，避免读到已被覆盖的数据
+    template <typename T>
+    void evalRangeTo(std::size_t first, std::size_t total, T* out, bool mayAlias) const
+    {
+        using matrix_expr_detail::kExprBlock;
+        T scratch[kExprBlock];
+        for (std::size_t done {0}; done < total; done += kExprBlock)
+        {
+            const std::size_t count {std::min(kExprBlock, total - done)};
+            T* buffer {mayAlias ? scratch : out + done};
+            const T* result {self().evalBlock(first + done, count, buffer)};
+            if (result != out + done)
+            {
+                std::copy(result, result + count, out + done);
+            }
+        }
+    }
+};
+
+// 叶子节点：引用一个已有的 Matrix
+template <typename T>
+class MatrixRef : public MatrixExpr<MatrixRef<T>>
+{
+private:
+    const Matrix<T>& m_;
+
+public:
+    using value_type = T;
+
+    explicit MatrixRef(const Matrix<T>& m) : m_{m} {}
+
+    std::size_t rows() const { return m_.rows(); }
+    std::size_t cols() const { return m_.cols(); }
+
+    const T* evalBlock(std::size_t offset, std::size_t /*count*/, T* /*buffer*/) const
+    {
+        return m_.data() + offset;
+    }
+};
+
+// 二元逐元素运算节点：左侧结果写入调用者给的 buffer，右侧写入自己栈上的临时块
+template <typename Op, typename L, typename R>
+class MatrixBinaryExpr : public MatrixExpr<MatrixBinaryExpr<Op, L, R>>
+{
+private:
+    L lhs_;
+    R rhs_;
+
+public:
+    using value_type = typename L::value_type;
+    static_assert(std::is_same<value_type, typename R::value_type>::value,
+                  "Matrix expression operands must have the same element type");
+
+    MatrixBinaryExpr(const L& lhs, const R& rhs) : lhs_{lhs}, rhs_{rhs}
+    {
+        if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols())
+        {
+            throw std::invalid_argument("Matrix dimensions do not match in expression");
+        }
+    }
+
+    std::size_t rows() const { return lhs_.rows(); }
+    std::size_t cols() const { return lhs_.cols(); }
+
+    const value_type* evalBlock(std::size_t offset, std::size_t count, value_type* buffer) const
+    {
+        value_type scratch[matrix_expr_detail::kExprBlock];
+        const value_type* a {lhs_.evalBlock(offset, count, buffer)};
+        const value_type* b {rhs_.evalBlock(offset, count, scratch)};
+        Op::apply(a, b, buffer, count);
+        return buffer;
+    }
+};
+
+// 标量缩放节点：expr * s 或 s * expr
+template <typename E>
+class MatrixScaleExpr : public MatrixExpr<MatrixScaleExpr<E>>
+{
+public:
+    using value_type = typename E::value_type;
+
+private:
+    E expr_;
+    value_type factor_;
+
+public:
+    MatrixScaleExpr(const E& expr, value_type factor) : expr_{expr}, factor_{factor} {}
+
+    std::size_t rows() const { return expr_.rows(); }
+    std::size_t cols() const { return expr_.cols(); }
+
+    const value_type* evalBlock(std::size_t offset, std::size_t count, value_type* buffer) const
+    {
+        const value_type* a {expr_.evalBlock(offset, count, buffer)};
+        matrix_expr_detail::scale(a, factor_, buffer, count);
+        return buffer;
+    }
+};
+
+namespace matrix_expr_detail
+{
+    // 把运算符的操作数统一成表达式节点：Matrix 包装成 MatrixRef，表达式原样返回
+    template <typename T>
+    MatrixRef<T> asExpr(const Matrix<T>& m) { return MatrixRef<T>{m}; }
+
+    template <typename E>
+    const E& asExpr(const MatrixExpr<E>& e) { return e.self(); }
+
+    template <typename X>
+    using ExprOf = std::decay_t<decltype(asExpr(std::declval<const X&>()))>;
+
+    // 只有 Matrix 和表达式才能参与下面的运算符，避免劫持其它类型的 + - *
+    template <typename X>
+    struct IsOperand : std::is_base_of<MatrixExpr<X>, X> {};
+    template <typename T>
+    struct IsOperand<Matrix<T>> : std::true_type {};
+}
+
+template <typename L, typename R,
+          typename = std::enable_if_t<matrix_expr_detail::IsOperand<L>::value && matrix_expr_detail::IsOperand<R>::value>>
+auto operator+(const L& lhs, const R& rhs)
+{
+    using namespace matrix_expr_detail;
+    return MatrixBinaryExpr<AddOp, ExprOf<L>, ExprOf<R>>(asExpr(lhs), asExpr(rhs));
+}
+
+template <typename L, typename R,
+          typename = std::enable_if_t<matrix_expr_detail::IsOperand<L>::value && matrix_expr_detail::IsOperand<R>::value>>
+auto operator-(const L& lhs, const R& rhs)
+{
+    using namespace matrix_expr_detail;
+    return MatrixBinaryExpr<SubOp, ExprOf<L>, ExprOf<R>>(asExpr(lhs), asExpr(rhs));
+}
+
+// 逐元素乘法。operator* 两边都是矩阵时含义不明确 (矩阵乘法还是逐元素？)，所以单独命名
+template <typename L, typename R,
+          typename = std::enable_if_t<matrix_expr_detail::IsOperand<L>::value && matrix_expr_detail::IsOperand<R>::value>>
+auto hadamard(const L& lhs, const R& rhs)
+{
+    using namespace matrix_expr_detail;
+    return MatrixBinaryExpr<MulOp, ExprOf<L>, ExprOf<R>>(asExpr(lhs), asExpr(rhs));
+}
+
+template <typename E, typename = std::enable_if_t<matrix_expr_detail::IsOperand<E>::value>>
+auto operator*(const E& expr, typename matrix_expr_detail::ExprOf<E>::value_type factor)
+{
+    using namespace matrix_expr_detail;
+    return MatrixScaleExpr<ExprOf<E>>(asExpr(expr), factor);
+}
+
+template <typename E, typename = std::enable_if_t<matrix_expr_detail::IsOperand<E>::value>>
+auto operator*(typename matrix_expr_detail::ExprOf<E>::value_type factor, const E& expr)
+{
+    return expr * factor;
+}
@@ -0,0 +1,173 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Ex2_matrix_alloc.hpp"
+#include "Ex2_matrix_io.hpp"
+
+template <typename Func>
+double measureMs(Func f)
+{
+    auto start {std::chrono::steady_clock::now()};
+    f();
+    auto end {std::chrono::steady_clock::now()};
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+std::size_t fileSize(const std::string& path)
+{
+    std::ifstream in {path, std::ios::binary | std::ios::ate};
+    return static_cast<std::size_t>(in.tellg());
+}
+
+template <typename T, typename A>
+bool sameMatrix(const Matrix<T, A>& a, const Matrix<T, A>& b)
+{
+    if (a.rows() != b.rows() || a.cols() != b.cols())
+    {
+        return false;
+    }
+    for (std::size_t i {0}; i < a.rows(); ++i)
+    {
+        for (std::size_t j {0}; j < a.cols(); ++j)
+        {
+            if (a(i, j) != b(i, j))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 保存、读取并验证一次，打印文件大小和吞吐量
+template <typename T, typename A>
+void roundTrip(const char* name, const Matrix<T, A>& m, MatrixStream::Encoding encoding, const std::string& path)
+{
+    const double rawBytes {static_cast<double>(m.rows() * m.cols() * sizeof(T))};
+    double saveMs {measureMs([&] { saveMatrix(path, m, encoding); })};
+    Matrix<T, A> loaded;
+    double loadMs {measureMs([&] { loaded = loadMatrix<T, A>(path); })};
+    const std::size_t bytes {fileSize(path)};
+    std::cout << name << ": 文件 " << bytes / 1024 << " KB (原始数据的 "
+              << 100.0 * static_cast<double>(bytes) / rawBytes << "%), 写入 "
+              << rawBytes / saveMs / 1e6 << " GB/s, 读取 " << rawBytes / loadMs / 1e6 << " GB/s, "
+              << (sameMatrix(m, loaded) ? "内容一致" : "内容不一致!") << '\n';
+}
+
+int main()
+{
+    // 1. 练习中的 8x5 矩阵：写进内存流再读回，逐行读取
+    Matrix<int> small(8, 5);
+    small.fill([](std::size_t i, std::size_t j) { return static_cast<int>(i * 5 + j) - 20; });
+    std::stringstream stream;
+    {
+        MatrixWriter<int> writer {stream, small.rows(), small.cols(), MatrixStream::Encoding::DeltaVarint};
+        for (std::size_t i {0}; i < small.rows(); ++i)
+        {
+            writer.writeRow(small.rowPtr(i));
+        }
+        writer.finish();
+    }
+    std::cout << "8x5 DeltaVarint 编码后 " << stream.str().size() << " 字节 (原始数据 "
+              << small.rows() * small.cols() * sizeof(int) << " 字节)\n";
+    MatrixReader<int> reader {stream};
+    int row[5];
+    for (std::size_t i {0}; i < reader.rows(); ++i)
+    {
+        reader.readRow(row);
+        for (int value : row)
+        {
+            std::cout << value << ' ';
+        }
+        std::cout << '\n';
+    }
+    reader.finish();
+
+    // 2. 2048x2048：平滑变化的数据 (类似图像、传感器采样) 与随机数据
+    const std::size_t n {2048};
+    Matrix<int> smooth(n, n);
+    smooth.fill([](std::size_t i, std::size_t j) { return static_cast<int>(i * 3 + j / 4 + (i ^ j) % 7); });
+    Matrix<int> noisy(n, n);
+    noisy.fill([](std::size_t i, std::size_t j)
+               { return static_cast<int>(static_cast<unsigned>((i * 2654435761u) ^ (j * 40503u)) * 2246822519u); });
+    Matrix<std::int64_t, CacheAlignedAllocation> wide(n, n);
+    wide.fill([](std::size_t i, std::size_t j) { return static_cast<std::int64_t>(i) * 1000000007LL - static_cast<std::int64_t>(j); });
+
+    const std::string path {"matrix_io_demo.bin"};
+    std::cout << "\n2048x2048:\n";
+    roundTrip("平滑 int     Raw        ", smooth, MatrixStream::Encoding::Raw, path);
+    roundTrip("平滑 int     DeltaVarint", smooth, MatrixStream::Encoding::DeltaVarint, path);
+    roundTrip("随机 int     Raw        ", noisy, MatrixStream::Encoding::Raw, path);
+    roundTrip("随机 int     DeltaVarint", noisy, MatrixStream::Encoding::DeltaVarint, path);
+    roundTrip("int64 (填充) DeltaVarint", wide, MatrixStream::Encoding::DeltaVarint, path);
+
+    // 3. 破坏文件中的一个字节，读取时应该被校验和发现
+    saveMatrix(path, smooth, MatrixStream::Encoding::DeltaVarint);
+    {
+        std::fstream file {path, std::ios::binary | std::ios::in | std::ios::out};
+        file.seekp(static_cast<std::streamoff>(sizeof(MatrixStream::Header) + 100));
+        file.put('\x7F');
+    }
+    try
+    {
+        loadMatrix<int>(path);
+        std::cout << "\n损坏的文件没有被发现!\n";
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cout << "\n损坏的文件: " << e.what() << '\n';
+    }
+
+    // 4. 元素类型不匹配
+    try
+    {
+        loadMatrix<double>(path);
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cout << "按 double 读取: " << e.what() << '\n';
+    }
+
+    // 5. 过长的 varint：在解码时就被拒绝 (不会移位越界)，不需要等到校验和
+    const auto decodeCorrupted = [](std::vector<std::uint8_t> block)
+    {
+        MatrixStream::Header header {};
+        std::memcpy(header.magic, MatrixStream::kMagic, sizeof(header.magic));
+        header.version = MatrixStream::kVersion;
+        header.elementType = static_cast<std::uint32_t>(MatrixFile::ElementType::Int32);
+        header.encoding = static_cast<std::uint32_t>(MatrixStream::Encoding::DeltaVarint);
+        header.rows = 1;
+        header.cols = 1;
+        const auto length {static_cast<std::uint32_t>(block.size())};
+        block.resize(MatrixStream::paddedTo4(block.size()), 0);
+        std::stringstream corrupted;
+        corrupted.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        corrupted.write(reinterpret_cast<const char*>(&length), 4);
+        corrupted.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size()));
+        MatrixReader<int> corruptedReader {corrupted};
+        int value;
+        try
+        {
+            corruptedReader.readRow(&value);
+            return std::string {"没有被发现!"};
+        }
+        catch (const std::runtime_error& e)
+        {
+            return std::string {e.what()};
+        }
+    };
+    std::cout << "\n6 字节的 varint: " << decodeCorrupted({0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01}) << '\n';
+    std::cout << "10 字节的 varint: "
+              << decodeCorrupted({0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01}) << '\n';
+    std::cout << "第 5 字节超出 32 位: " << decodeCorrupted({0xFF, 0xFF, 0xFF, 0xFF, 0x7F}) << '\n';
+    std::cout << "第 5 字节超出 32 位 (后面还有数据): "
+              << decodeCorrupted({0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0x00, 0x00, 0x00}) << '\n';
+
+    std::remove(path.c_str());
+    return 0;
+}
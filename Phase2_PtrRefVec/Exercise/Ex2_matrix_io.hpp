@@ -0,0 +1,446 @@
+#pragma once
+
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint8_t, std::uint32_t, std::uint64_t
+#include <cstring>     // std::memcpy, std::memcmp
+#include <fstream>     // std::ofstream, std::ifstream
+#include <istream>     // std::istream
+#include <ostream>     // std::ostream
+#include <stdexcept>   // std::runtime_error, std::invalid_argument
+#include <string>      // std::string
+#include <type_traits> // std::is_integral, std::make_unsigned_t, std::make_signed_t
+#include <vector>      // std::vector
+
+#include "Ex2_matrix.hpp"
+#include "Ex2_matrix_mmap.hpp" // MatrixFile::ElementType, MatrixFile::ElementTypeOf
+
+// 矩阵的二进制序列化格式 (小端)，用于保存和交换矩阵：
+//
+//   Header (40 字节)
+//     magic[8]     "CPPLMSER"
+//     version      u32
+//     elementType  u32  (MatrixFile::ElementType)
+//     encoding     u32  (MatrixStream::Encoding)
+//     reserved     u32
+//     rows, cols   u64, u64
+//   Payload
+//     Raw:        rows * cols 个元素原样存放，读取时直接 read 进矩阵内存，不需要任何解析
+//     DeltaVarint: 每行一个块 —— u32 字节数 + 编码后的字节 + 补齐到 4 字节的填充
+//                  行内每个元素与前一个元素作差 (delta)，差值用 zigzag 映射成无符号数，
+//                  再用 varint 编码 (每字节 7 位数据 + 1 位"后面还有"标志)；
+//                  平滑变化的数据绝大多数差值只需要 1 个字节
+//   Trailer
+//     checksum     u64  对整个 Payload 计算的 Fletcher 风格校验和
+//
+// 每行单独成块，读取时可以一行一行地流式解码，只需要一行大小的缓冲区。
+namespace MatrixStream
+{
+    constexpr char kMagic[8] {'C', 'P', 'P', 'L', 'M', 'S', 'E', 'R'};
+    constexpr std::uint32_t kVersion {1};
+
+    enum class Encoding : std::uint32_t
+    {
+        Raw = 0,
+        DeltaVarint = 1,
+    };
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "MatrixStream assumes a little-endian host"
+#endif
+
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t elementType;
+        std::uint32_t encoding;
+        std::uint32_t reserved;
+        std::uint64_t rows;
+        std::uint64_t cols;
+    };
+    static_assert(sizeof(Header) == 40, "MatrixStream::Header must be 40 bytes");
+
+    // Fletcher 风格的校验和：按 32 位字累加两个 64 位和 (a 是简单和，b 是 a 的累加和)。
+    // b 对字的顺序敏感，能发现交换、丢失和单个比特的错误；每 4 字节只需两次加法。
+    // 所有数据块的长度都是 4 的整数倍。
+    class Checksum
+    {
+    private:
+        std::uint64_t a_ {0};
+        std::uint64_t b_ {0};
+
+    public:
+        void update(const void* data, std::size_t bytes)
+        {
+            const auto* p {static_cast<const unsigned char*>(data)};
+            for (std::size_t i {0}; i + 4 <= bytes; i += 4)
+            {
+                std::uint32_t word;
+                std::memcpy(&word, p + i, 4);
+                a_ += word;
+                b_ += a_;
+            }
+        }
+
+        std::uint64_t value() const { return (b_ << 32) ^ (b_ >> 32) ^ a_; }
+    };
+
+    // zigzag：0, -1, 1, -2, 2 ... 映射成 0, 1, 2, 3, 4 ...，让小的负数也只占很少的字节
+    template <typename U>
+    inline U zigzagEncode(U delta)
+    {
+        using S = std::make_signed_t<U>;
+        return (delta << 1) ^ static_cast<U>(static_cast<S>(delta) >> (sizeof(U) * 8 - 1));
+    }
+
+    template <typename U>
+    inline U zigzagDecode(U value)
+    {
+        return (value >> 1) ^ (U {0} - (value & 1));
+    }
+
+    // 编码一整行，追加到 out。差值在无符号类型上计算，溢出时按模回绕，解码时同样回绕还原
+    template <typename T>
+    void encodeRow(const T* row, std::size_t count, std::vector<std::uint8_t>& out)
+    {
+        using U = std::make_unsigned_t<T>;
+        U previous {0};
+        for (std::size_t j {0}; j < count; ++j)
+        {
+            const U current {static_cast<U>(row[j])};
+            U value {zigzagEncode<U>(static_cast<U>(current - previous))};
+            previous = current;
+            while (value >= 0x80)
+            {
+                out.push_back(static_cast<std::uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<std::uint8_t>(value));
+        }
+    }
+
+    // 一个 varint 最多占多少字节：U 的每 7 位一个字节
+    template <typename U>
+    constexpr std::size_t kMaxVarintBytes {(sizeof(U) * 8 + 6) / 7};
+
+    // 逐字节解码一个 varint (第一个字节已经读出，且带"后面还有"标志)。
+    // 超过 kMaxVarintBytes 个字节，或者最后一个字节的数据位放不进 U，都说明数据已经损坏：
+    // 在移位之前就拒绝，避免移位超过 U 的位数 (未定义行为)，不必等到最后的校验和
+    template <typename U>
+    U decodeVarintSlow(U value, const std::uint8_t*& p, const std::uint8_t* end)
+    {
+        constexpr unsigned kBits {sizeof(U) * 8};
+        value &= 0x7F;
+        unsigned shift {7};
+        std::uint8_t byte;
+        do
+        {
+            if (p >= end || shift >= kBits)
+            {
+                throw std::runtime_error("Corrupted matrix stream: bad varint");
+            }
+            byte = *p++;
+            const unsigned payload {byte & 0x7Fu};
+            if (kBits - shift < 7 && (payload >> (kBits - shift)) != 0)
+            {
+                throw std::runtime_error("Corrupted matrix stream: bad varint");
+            }
+            value |= static_cast<U>(static_cast<U>(payload) << shift);
+            shift += 7;
+        } while (byte & 0x80);
+        return value;
+    }
+
+    // 解码一整行。
+    // 单字节 (差值在 [-64, 63] 之间) 是平滑数据中最常见的情况，单独作为快速路径。
+    // 多字节的 varint 在后面至少还有 8 个字节时一次读 8 个字节，不按字节循环：
+    // 用"后面还有"标志位找到 varint 的结尾，再用三步移位把每字节的 7 位数据拼到一起。
+    // 随机数据的 varint 长度不可预测，按字节循环时几乎每个元素都会有一次分支预测失败。
+    // 超过 8 个字节 (只有 64 位整数可能出现)、长度或数值越界时交给 decodeVarintSlow，由它报错。
+    template <typename T>
+    void decodeRow(const std::uint8_t* p, const std::uint8_t* end, T* row, std::size_t count)
+    {
+        using U = std::make_unsigned_t<T>;
+        constexpr unsigned kBits {sizeof(U) * 8};
+        U previous {0};
+        for (std::size_t j {0}; j < count; ++j)
+        {
+            if (p >= end)
+            {
+                throw std::runtime_error("Corrupted matrix stream: row block too short");
+            }
+            U value {*p};
+            if (value < 0x80)
+            {
+                ++p;
+            }
+            else if (end - p >= 8)
+            {
+                std::uint64_t word;
+                std::memcpy(&word, p, 8);
+                const std::uint64_t stops {~word & 0x8080808080808080ULL};
+                // stops ^ (stops - 1) 保留最低的结束标志及以下的位，正好是这个 varint 的所有字节
+                std::uint64_t bits {word & (stops ^ (stops - 1)) & 0x7F7F7F7F7F7F7F7FULL};
+                bits = ((bits & 0x7F007F007F007F00ULL) >> 1) | (bits & 0x007F007F007F007FULL);
+                bits = ((bits & 0x3FFF00003FFF0000ULL) >> 2) | (bits & 0x00003FFF00003FFFULL);
+                bits = ((bits & 0x0FFFFFFF00000000ULL) >> 4) | (bits & 0x000000000FFFFFFFULL);
+                const unsigned length {static_cast<unsigned>(__builtin_ctzll(stops | (std::uint64_t {1} << 63))) / 8 + 1};
+                if (stops != 0 && length <= kMaxVarintBytes<U> && (kBits >= 64 || (bits >> (kBits % 64)) == 0))
+                {
+                    value = static_cast<U>(bits);
+                    p += length;
+                }
+                else
+                {
+                    ++p;
+                    value = decodeVarintSlow<U>(value, p, end);
+                }
+            }
+            else
+            {
+                ++p;
+                value = decodeVarintSlow<U>(value, p, end);
+            }
+            previous = static_cast<U>(previous + zigzagDecode<U>(value));
+            row[j] = static_cast<T>(previous);
+        }
+    }
+
+    inline std::size_t paddedTo4(std::size_t bytes)
+    {
+        return (bytes + 3) & ~std::size_t {3};
+    }
+}
+
+// 流式写入：先写文件头，然后逐行 writeRow，最后 finish 写入校验和
+template <typename T>
+class MatrixWriter
+{
+private:
+    std::ostream& out_;
+    std::size_t rows_;
+    std::size_t cols_;
+    MatrixStream::Encoding encoding_;
+    std::size_t rowsWritten_ {0};
+    MatrixStream::Checksum checksum_;
+    std::vector<std::uint8_t> buffer_;
+
+    void write(const void* data, std::size_t bytes)
+    {
+        checksum_.update(data, bytes);
+        out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    }
+
+public:
+    MatrixWriter(std::ostream& out, std::size_t rows, std::size_t cols,
+                 MatrixStream::Encoding encoding = MatrixStream::Encoding::Raw)
+        : out_{out}, rows_{rows}, cols_{cols}, encoding_{encoding}
+    {
+        if (encoding == MatrixStream::Encoding::DeltaVarint && !std::is_integral<T>::value)
+        {
+            throw std::invalid_argument("DeltaVarint encoding requires an integer element type");
+        }
+        MatrixStream::Header header {};
+        std::memcpy(header.magic, MatrixStream::kMagic, sizeof(header.magic));
+        header.version = MatrixStream::kVersion;
+        header.elementType = static_cast<std::uint32_t>(MatrixFile::ElementTypeOf<T>::value);
+        header.encoding = static_cast<std::uint32_t>(encoding);
+        header.rows = rows;
+        header.cols = cols;
+        out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    void writeRow(const T* row)
+    {
+        if (rowsWritten_ == rows_)
+        {
+            throw std::logic_error("MatrixWriter: all rows have already been written");
+        }
+        if (encoding_ == MatrixStream::Encoding::Raw)
+        {
+            write(row, cols_ * sizeof(T));
+        }
+        else
+        {
+            if constexpr (std::is_integral<T>::value)
+            {
+                buffer_.assign(4, 0); // 预留行长度字段
+                MatrixStream::encodeRow(row, cols_, buffer_);
+                const auto length {static_cast<std::uint32_t>(buffer_.size() - 4)};
+                std::memcpy(buffer_.data(), &length, 4);
+                buffer_.resize(4 + MatrixStream::paddedTo4(length), 0);
+                write(buffer_.data(), buffer_.size());
+            }
+        }
+        ++rowsWritten_;
+    }
+
+    // 写入校验和。行数不足时抛异常，避免生成不完整的文件
+    void finish()
+    {
+        if (rowsWritten_ != rows_)
+        {
+            throw std::logic_error("MatrixWriter: not all rows were written");
+        }
+        const std::uint64_t sum {checksum_.value()};
+        out_.write(reinterpret_cast<const char*>(&sum), sizeof(sum));
+        out_.flush();
+        if (!out_)
+        {
+            throw std::runtime_error("MatrixWriter: write failed");
+        }
+    }
+};
+
+// 流式读取：构造时读取并校验文件头，然后逐行 readRow，最后 finish 校验校验和
+template <typename T>
+class MatrixReader
+{
+private:
+    std::istream& in_;
+    std::size_t rows_ {0};
+    std::size_t cols_ {0};
+    MatrixStream::Encoding encoding_ {MatrixStream::Encoding::Raw};
+    std::size_t rowsRead_ {0};
+    MatrixStream::Checksum checksum_;
+    std::vector<std::uint8_t> buffer_;
+
+    void read(void* data, std::size_t bytes)
+    {
+        if (!in_.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes)))
+        {
+            throw std::runtime_error("Corrupted matrix stream: unexpected end of data");
+        }
+        checksum_.update(data, bytes);
+    }
+
+public:
+    explicit MatrixReader(std::istream& in) : in_{in}
+    {
+        MatrixStream::Header header;
+        if (!in_.read(reinterpret_cast<char*>(&header), sizeof(header))
+            || std::memcmp(header.magic, MatrixStream::kMagic, sizeof(header.magic)) != 0)
+        {
+            throw std::runtime_error("Not a matrix stream");
+        }
+        if (header.version != MatrixStream::kVersion)
+        {
+            throw std::runtime_error("Unsupported matrix stream version");
+        }
+        if (header.elementType != static_cast<std::uint32_t>(MatrixFile::ElementTypeOf<T>::value))
+        {
+            throw std::runtime_error("Matrix stream element type does not match");
+        }
+        if (header.encoding > static_cast<std::uint32_t>(MatrixStream::Encoding::DeltaVarint)
+            || (header.encoding == static_cast<std::uint32_t>(MatrixStream::Encoding::DeltaVarint)
+                && !std::is_integral<T>::value))
+        {
+            throw std::runtime_error("Unsupported matrix stream encoding");
+        }
+        rows_ = static_cast<std::size_t>(header.rows);
+        cols_ = static_cast<std::size_t>(header.cols);
+        encoding_ = static_cast<MatrixStream::Encoding>(header.encoding);
+    }
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    MatrixStream::Encoding encoding() const { return encoding_; }
+
+    void readRow(T* row)
+    {
+        readRows(row, cols_, 1);
+    }
+
+    // 连续读取 count 行，第 k 行写到 first + k * stride。
+    // Raw 编码且 stride == cols 时只调用一次 read，数据直接落进目标内存
+    void readRows(T* first, std::size_t stride, std::size_t count)
+    {
+        if (rowsRead_ + count > rows_)
+        {
+            throw std::logic_error("MatrixReader: reading past the last row");
+        }
+        if (encoding_ == MatrixStream::Encoding::Raw)
+        {
+            if (stride == cols_)
+            {
+                read(first, count * cols_ * sizeof(T));
+            }
+            else
+            {
+                for (std::size_t k {0}; k < count; ++k)
+                {
+                    read(first + k * stride, cols_ * sizeof(T));
+                }
+            }
+        }
+        else
+        {
+            if constexpr (std::is_integral<T>::value)
+            {
+                for (std::size_t k {0}; k < count; ++k)
+                {
+                    std::uint32_t length;
+                    read(&length, 4);
+                    buffer_.resize(MatrixStream::paddedTo4(length));
+                    read(buffer_.data(), buffer_.size());
+                    MatrixStream::decodeRow(buffer_.data(), buffer_.data() + length, first + k * stride, cols_);
+                }
+            }
+        }
+        rowsRead_ += count;
+    }
+
+    // 读取并比较校验和，不一致时抛异常
+    void finish()
+    {
+        if (rowsRead_ != rows_)
+        {
+            throw std::logic_error("MatrixReader: not all rows were read");
+        }
+        std::uint64_t stored;
+        if (!in_.read(reinterpret_cast<char*>(&stored), sizeof(stored)))
+        {
+            throw std::runtime_error("Corrupted matrix stream: missing checksum");
+        }
+        if (stored != checksum_.value())
+        {
+            throw std::runtime_error("Corrupted matrix stream: checksum mismatch");
+        }
+    }
+};
+
+// 便捷函数：整个矩阵写入文件 / 从文件读取
+template <typename T, typename A>
+void saveMatrix(const std::string& path, const Matrix<T, A>& m,
+                MatrixStream::Encoding encoding = MatrixStream::Encoding::Raw)
+{
+    std::ofstream out {path, std::ios::binary};
+    if (!out)
+    {
+        throw std::runtime_error("Cannot open " + path + " for writing");
+    }
+    MatrixWriter<T> writer {out, m.rows(), m.cols(), encoding};
+    for (std::size_t i {0}; i < m.rows(); ++i)
+    {
+        writer.writeRow(m.rowPtr(i));
+    }
+    writer.finish();
+}
+
+template <typename T, typename A = DefaultAllocation>
+Matrix<T, A> loadMatrix(const std::string& path)
+{
+    std::ifstream in {path, std::ios::binary};
+    if (!in)
+    {
+        throw std::runtime_error("Cannot open " + path + " for reading");
+    }
+    MatrixReader<T> reader {in};
+    Matrix<T, A> m(reader.rows(), reader.cols());
+    if (!m.empty())
+    {
+        reader.readRows(m.data(), m.stride(), m.rows());
+    }
+    reader.finish();
+    return m;
+}
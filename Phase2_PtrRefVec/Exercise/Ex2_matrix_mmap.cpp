@@ -0,0 +1,107 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "Ex2_matrix_mmap.hpp"
+
+template <typename Func>
+double measureMs(Func f)
+{
+    auto start {std::chrono::steady_clock::now()};
+    f();
+    auto end {std::chrono::steady_clock::now()};
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main()
+{
+    const std::string path {"Ex2_matrix_mmap_demo.bin"};
+    const std::size_t rows {4096};
+    const std::size_t cols {1024};
+
+    // 1. 创建文件并按块写入 (i+1)*(j+1)，和前面几个练习的填充方式一致
+    {
+        MappedMatrix<std::int32_t> out {MappedMatrix<std::int32_t>::create(path, rows, cols)};
+        out.forEachTileMutable(256, [cols](std::size_t rowBegin, std::size_t rowEnd, std::int32_t* tile) {
+            for (std::size_t i {rowBegin}; i < rowEnd; ++i)
+            {
+                std::int32_t* row {tile + (i - rowBegin) * cols};
+                for (std::size_t j {0}; j < cols; ++j)
+                {
+                    row[j] = static_cast<std::int32_t>((i + 1) * (j + 1));
+                }
+            }
+        });
+        out.flush();
+    } // 离开作用域时自动 munmap + close
+
+    // 2. 只读打开：只建立映射，几乎不花时间
+    MappedMatrix<std::int32_t> in;
+    double openMs {measureMs([&] { in = MappedMatrix<std::int32_t>::open(path, MapMode::ReadOnly); })};
+    std::cout << "打开 " << in.rows() << 'x' << in.cols() << " 的矩阵文件耗时 " << openMs << " ms\n";
+
+    // 3. 顺序按块求和
+    in.advise(AccessHint::Sequential);
+    std::int64_t total {0};
+    double sumMs {measureMs([&] {
+        in.forEachTile(256, [&total, cols](std::size_t rowBegin, std::size_t rowEnd, const std::int32_t* tile) {
+            for (std::size_t k {0}; k < (rowEnd - rowBegin) * cols; ++k)
+            {
+                total += tile[k];
+            }
+        });
+    })};
+
+    // sum((i+1)*(j+1)) = (rows(rows+1)/2) * (cols(cols+1)/2)
+    const std::int64_t expected {static_cast<std::int64_t>(rows * (rows + 1) / 2) * static_cast<std::int64_t>(cols * (cols + 1) / 2)};
+    std::cout << "分块求和 " << total << (total == expected ? " (正确)" : " (错误)") << ", 耗时 " << sumMs << " ms\n";
+    std::cout << "in(7, 4) = " << in(7, 4) << '\n';
+
+    // 4. 只读映射上请求可写指针会抛异常，而不是等到写入时段错误
+    try
+    {
+        in.rowPtr(0)[0] = 42;
+    }
+    catch (const std::logic_error& e)
+    {
+        std::cout << "写入只读映射被拒绝: " << e.what() << '\n';
+    }
+
+    in = MappedMatrix<std::int32_t> {};
+
+    // 5. 伪造的文件头：rows * cols * sizeof(T) 回绕成一个很小的数，不能通过长度检查
+    const auto openForged = [&path](std::uint64_t rows, std::uint64_t cols, std::uint64_t dataOffset)
+    {
+        MatrixFile::Header header {};
+        std::memcpy(header.magic, MatrixFile::kMagic, sizeof(header.magic));
+        header.version = MatrixFile::kVersion;
+        header.elementType = static_cast<std::uint32_t>(MatrixFile::ElementType::Int32);
+        header.rows = rows;
+        header.cols = cols;
+        header.dataOffset = dataOffset;
+        std::FILE* file {std::fopen(path.c_str(), "wb")};
+        std::fwrite(&header, sizeof(header), 1, file);
+        const char page[MatrixFile::kDataOffset] {};
+        std::fwrite(page, 1, sizeof(page) - sizeof(header), file);
+        std::fwrite(page, 1, sizeof(page), file);
+        std::fclose(file);
+        try
+        {
+            MappedMatrix<std::int32_t>::open(path);
+            return std::string {"打开成功"};
+        }
+        catch (const std::runtime_error& e)
+        {
+            return std::string {e.what()};
+        }
+    };
+    std::cout << "rows * cols 溢出: " << openForged(std::uint64_t {1} << 62, 4, MatrixFile::kDataOffset) << '\n';
+    std::cout << "dataOffset + 数据大小溢出: " << openForged(1, 1024, ~(MatrixFile::kDataOffset - 1)) << '\n';
+    std::cout << "dataOffset 在文件头内部: " << openForged(1, 16, 8) << '\n';
+    std::cout << "正常的 1x16 文件: " << openForged(1, 16, MatrixFile::kDataOffset) << '\n';
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,386 @@
+#pragma once
+
+#include <algorithm>    // std::min
+#include <cerrno>       // errno
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <cstring>      // std::memcmp, std::memcpy
+#include <limits>       // std::numeric_limits
+#include <stdexcept>    // std::runtime_error, std::logic_error, std::length_error
+#include <string>       // std::string
+#include <system_error> // std::system_error
+
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, munmap, madvise, msync
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close, ftruncate, sysconf
+
+#include "Ex2_matrix.hpp"
+
+// 方案五：数据不在堆上，而在磁盘文件里 (out-of-core)。
+// 用 mmap 把整个文件映射进地址空间：打开一个 50 GB 的矩阵只是建立映射，
+// 不读任何数据；真正访问某一页时才由操作系统按需调入 (缺页中断)。
+//
+// 文件格式 (小端)：
+//   [0, 64)      MatrixFileHeader
+//   [64, 4096)   填充，保证数据从页边界开始，方便按页 madvise
+//   [4096, ...)  rows * cols 个元素，行主序
+namespace MatrixFile
+{
+    constexpr char kMagic[8] {'C', 'P', 'P', 'L', 'M', 'A', 'T', '\0'};
+    constexpr std::uint32_t kVersion {1};
+    constexpr std::uint64_t kDataOffset {4096};
+
+    // 元素类型编码，写在文件头里，打开时校验，防止把 double 文件当 int 读
+    enum class ElementType : std::uint32_t
+    {
+        Int32 = 1,
+        Int64 = 2,
+        Float32 = 3,
+        Float64 = 4,
+    };
+
+    template <typename T>
+    struct ElementTypeOf;
+    template <> struct ElementTypeOf<std::int32_t> { static constexpr ElementType value {ElementType::Int32}; };
+    template <> struct ElementTypeOf<std::int64_t> { static constexpr ElementType value {ElementType::Int64}; };
+    template <> struct ElementTypeOf<float> { static constexpr ElementType value {ElementType::Float32}; };
+    template <> struct ElementTypeOf<double> { static constexpr ElementType value {ElementType::Float64}; };
+
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t elementType;
+        std::uint64_t rows;
+        std::uint64_t cols;
+        std::uint64_t dataOffset;
+        std::uint8_t reserved[24];
+    };
+    static_assert(sizeof(Header) == 64, "MatrixFile::Header must be 64 bytes");
+}
+
+enum class MapMode
+{
+    ReadOnly,
+    ReadWrite,
+};
+
+// 访问模式提示，对应 madvise 的几个常用选项
+enum class AccessHint
+{
+    Normal,
+    Sequential, // 顺序访问：内核会加大预读，并更早回收已读过的页
+    Random,     // 随机访问：关闭预读，避免读入用不到的页
+};
+
+template <typename T>
+class MappedMatrix
+{
+private:
+    int fd_ {-1};
+    void* base_ {nullptr};     // 映射的起始地址 (文件开头)
+    std::size_t mappedBytes_ {0};
+    T* data_ {nullptr};        // 指向第一个元素 (base_ + dataOffset)
+    std::size_t rows_ {0};
+    std::size_t cols_ {0};
+    bool writable_ {false};
+
+    [[noreturn]] static void throwErrno(const std::string& what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    static std::size_t pageSize()
+    {
+        static const std::size_t size {static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))};
+        return size;
+    }
+
+    void map(const std::string& path, MapMode mode)
+    {
+        struct stat st {};
+        if (::fstat(fd_, &st) != 0)
+        {
+            throwErrno("fstat " + path);
+        }
+        mappedBytes_ = static_cast<std::size_t>(st.st_size);
+        if (mappedBytes_ < sizeof(MatrixFile::Header))
+        {
+            throw std::runtime_error(path + ": file too small for a matrix header");
+        }
+
+        const int prot {mode == MapMode::ReadWrite ? PROT_READ | PROT_WRITE : PROT_READ};
+        // MAP_SHARED：写入直接反映到文件 (经由页缓存)，不占用匿名内存
+        base_ = ::mmap(nullptr, mappedBytes_, prot, MAP_SHARED, fd_, 0);
+        if (base_ == MAP_FAILED)
+        {
+            base_ = nullptr;
+            throwErrno("mmap " + path);
+        }
+        writable_ = mode == MapMode::ReadWrite;
+
+        MatrixFile::Header header;
+        std::memcpy(&header, base_, sizeof(header));
+        if (std::memcmp(header.magic, MatrixFile::kMagic, sizeof(header.magic)) != 0
+            || header.version != MatrixFile::kVersion)
+        {
+            throw std::runtime_error(path + ": not a matrix file");
+        }
+        if (header.elementType != static_cast<std::uint32_t>(MatrixFile::ElementTypeOf<T>::value))
+        {
+            throw std::runtime_error(path + ": element type does not match");
+        }
+        // 文件头里的字段不可信：数据必须在文件头之后、按页对齐 (写入方总是用 kDataOffset)，
+        // 大小的计算不能溢出，否则伪造的文件可以通过长度检查，映射出比文件大得多的矩阵
+        if (header.dataOffset < sizeof(MatrixFile::Header) || header.dataOffset % MatrixFile::kDataOffset != 0)
+        {
+            throw std::runtime_error(path + ": bad data offset");
+        }
+        std::uint64_t dataBytes;
+        std::uint64_t endOffset;
+        if (__builtin_mul_overflow(header.rows, header.cols, &dataBytes)
+            || __builtin_mul_overflow(dataBytes, sizeof(T), &dataBytes)
+            || __builtin_add_overflow(header.dataOffset, dataBytes, &endOffset))
+        {
+            throw std::runtime_error(path + ": matrix dimensions overflow");
+        }
+        if (endOffset > mappedBytes_)
+        {
+            throw std::runtime_error(path + ": file is truncated");
+        }
+        rows_ = static_cast<std::size_t>(header.rows);
+        cols_ = static_cast<std::size_t>(header.cols);
+        data_ = reinterpret_cast<T*>(static_cast<char*>(base_) + header.dataOffset);
+    }
+
+    void release() noexcept
+    {
+        if (base_ != nullptr)
+        {
+            ::munmap(base_, mappedBytes_);
+        }
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+        }
+        fd_ = -1;
+        base_ = nullptr;
+        data_ = nullptr;
+        mappedBytes_ = 0;
+        rows_ = 0;
+        cols_ = 0;
+        writable_ = false;
+    }
+
+    // 对 [rowBegin, rowEnd) 所在的页调用 madvise；地址必须向下对齐到页边界
+    void adviseRows(std::size_t rowBegin, std::size_t rowEnd, int advice) const
+    {
+        if (rowBegin >= rowEnd)
+        {
+            return;
+        }
+        const auto first {reinterpret_cast<std::uintptr_t>(data_ + rowBegin * cols_)};
+        const auto last {reinterpret_cast<std::uintptr_t>(data_ + rowEnd * cols_)};
+        const std::uintptr_t aligned {first & ~(static_cast<std::uintptr_t>(pageSize()) - 1)};
+        ::madvise(reinterpret_cast<void*>(aligned), last - aligned, advice);
+    }
+
+public:
+    MappedMatrix() = default;
+
+    // 创建一个新文件 (已存在则覆盖) 并以读写方式映射。
+    // ftruncate 只设置文件长度，在大多数文件系统上生成稀疏文件，不会真的写满磁盘。
+    static MappedMatrix create(const std::string& path, std::size_t rows, std::size_t cols)
+    {
+        MappedMatrix m;
+        m.fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (m.fd_ < 0)
+        {
+            throwErrno("open " + path);
+        }
+
+        MatrixFile::Header header {};
+        std::memcpy(header.magic, MatrixFile::kMagic, sizeof(header.magic));
+        header.version = MatrixFile::kVersion;
+        header.elementType = static_cast<std::uint32_t>(MatrixFile::ElementTypeOf<T>::value);
+        header.rows = rows;
+        header.cols = cols;
+        header.dataOffset = MatrixFile::kDataOffset;
+
+        std::uint64_t fileBytes;
+        if (__builtin_mul_overflow(static_cast<std::uint64_t>(rows), cols, &fileBytes)
+            || __builtin_mul_overflow(fileBytes, sizeof(T), &fileBytes)
+            || __builtin_add_overflow(fileBytes, MatrixFile::kDataOffset, &fileBytes)
+            || fileBytes > static_cast<std::uint64_t>(std::numeric_limits<off_t>::max()))
+        {
+            throw std::length_error("MappedMatrix::create: matrix too large");
+        }
+        if (::ftruncate(m.fd_, static_cast<off_t>(fileBytes)) != 0)
+        {
+            throwErrno("ftruncate " + path);
+        }
+        if (::pwrite(m.fd_, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)))
+        {
+            throwErrno("write header " + path);
+        }
+        m.map(path, MapMode::ReadWrite);
+        return m;
+    }
+
+    // 打开已有的矩阵文件；只建立映射，不读取数据
+    static MappedMatrix open(const std::string& path, MapMode mode = MapMode::ReadOnly)
+    {
+        MappedMatrix m;
+        m.fd_ = ::open(path.c_str(), mode == MapMode::ReadWrite ? O_RDWR : O_RDONLY);
+        if (m.fd_ < 0)
+        {
+            throwErrno("open " + path);
+        }
+        m.map(path, mode);
+        return m;
+    }
+
+    // 把内存中的 Matrix 写成矩阵文件
+    static void save(const std::string& path, const Matrix<T>& source)
+    {
+        MappedMatrix m {create(path, source.rows(), source.cols())};
+        std::copy(source.data(), source.data() + source.size(), m.data());
+        m.flush();
+    }
+
+    ~MappedMatrix()
+    {
+        release();
+    }
+
+    // 映射和文件描述符都是独占资源：只能移动，不能拷贝
+    MappedMatrix(const MappedMatrix&) = delete;
+    MappedMatrix& operator=(const MappedMatrix&) = delete;
+
+    MappedMatrix(MappedMatrix&& other) noexcept
+        : fd_{other.fd_}, base_{other.base_}, mappedBytes_{other.mappedBytes_}, data_{other.data_},
+          rows_{other.rows_}, cols_{other.cols_}, writable_{other.writable_}
+    {
+        other.fd_ = -1;
+        other.base_ = nullptr;
+        other.data_ = nullptr;
+        other.mappedBytes_ = 0;
+        other.rows_ = 0;
+        other.cols_ = 0;
+        other.writable_ = false;
+    }
+
+    MappedMatrix& operator=(MappedMatrix&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            fd_ = other.fd_;
+            base_ = other.base_;
+            mappedBytes_ = other.mappedBytes_;
+            data_ = other.data_;
+            rows_ = other.rows_;
+            cols_ = other.cols_;
+            writable_ = other.writable_;
+            other.fd_ = -1;
+            other.base_ = nullptr;
+            other.data_ = nullptr;
+            other.mappedBytes_ = 0;
+            other.rows_ = 0;
+            other.cols_ = 0;
+            other.writable_ = false;
+        }
+        return *this;
+    }
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    std::size_t size() const { return rows_ * cols_; }
+    bool writable() const { return writable_; }
+
+    const T* data() const { return data_; }
+    const T* rowPtr(std::size_t row) const { return data_ + row * cols_; }
+
+    // 只读映射上的页没有写权限，写入会直接触发 SIGSEGV；这里提前抛异常
+    T* data()
+    {
+        if (!writable_)
+        {
+            throw std::logic_error("MappedMatrix is mapped read-only");
+        }
+        return data_;
+    }
+
+    T* rowPtr(std::size_t row) { return data() + row * cols_; }
+
+    const T& operator()(std::size_t row, std::size_t col) const { return data_[row * cols_ + col]; }
+
+    const T& at(std::size_t row, std::size_t col) const
+    {
+        if (row >= rows_ || col >= cols_)
+        {
+            throw std::out_of_range("Index out of bounds");
+        }
+        return data_[row * cols_ + col];
+    }
+
+    // 对整个数据区给出访问模式提示
+    void advise(AccessHint hint) const
+    {
+        const int advice {hint == AccessHint::Sequential ? MADV_SEQUENTIAL
+                          : hint == AccessHint::Random   ? MADV_RANDOM
+                                                         : MADV_NORMAL};
+        adviseRows(0, rows_, advice);
+    }
+
+    // 把修改过的页同步写回磁盘
+    void flush()
+    {
+        if (writable_ && base_ != nullptr && ::msync(base_, mappedBytes_, MS_SYNC) != 0)
+        {
+            throwErrno("msync");
+        }
+    }
+
+    // 按 tileRows 行一块顺序遍历：处理当前块之前先对下一块发出 MADV_WILLNEED (异步预读)，
+    // 处理完后对当前块发出 MADV_DONTNEED，让已经用过的页尽早离开本进程的常驻内存，
+    // 这样即使文件远大于内存，占用也只与 tileRows 有关。
+    // f(rowBegin, rowEnd, firstRow)，firstRow 指向第 rowBegin 行。
+    template <typename Func>
+    void forEachTile(std::size_t tileRows, Func f) const
+    {
+        tileRows = std::max<std::size_t>(tileRows, 1);
+        adviseRows(0, std::min(tileRows, rows_), MADV_WILLNEED);
+        for (std::size_t begin {0}; begin < rows_; begin += tileRows)
+        {
+            const std::size_t end {std::min(begin + tileRows, rows_)};
+            adviseRows(end, std::min(end + tileRows, rows_), MADV_WILLNEED);
+            f(begin, end, static_cast<const T*>(data_ + begin * cols_));
+            adviseRows(begin, end, MADV_DONTNEED);
+        }
+    }
+
+    // 可写版本：同样对下一块预读，但不对写过的块调用 MADV_DONTNEED，
+    // 脏页交给内核按正常的回写机制写回文件
+    template <typename Func>
+    void forEachTileMutable(std::size_t tileRows, Func f)
+    {
+        tileRows = std::max<std::size_t>(tileRows, 1);
+        T* base {data()};
+        for (std::size_t begin {0}; begin < rows_; begin += tileRows)
+        {
+            const std::size_t end {std::min(begin + tileRows, rows_)};
+            adviseRows(end, std::min(end + tileRows, rows_), MADV_WILLNEED);
+            f(begin, end, base + begin * cols_);
+        }
+    }
+
+    // 拷贝到内存中的 Matrix (数据必须装得下内存)
+    Matrix<T> toMatrix() const
+    {
+        Matrix<T> result(rows_, cols_);
+        std::copy(data_, data_ + size(), result.data());
+        return result;
+    }
+};
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#include "Ex2_matrix_parallel.hpp"
+
+template <typename Func>
+double measureMs(Func f)
+{
+    auto start {std::chrono::steady_clock::now()};
+    f();
+    auto end {std::chrono::steady_clock::now()};
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// 机器上的其他负载会让单次计时波动很大，取几次中最快的一次
+template <typename Func>
+double bestOfMs(int repeats, Func f)
+{
+    double best {measureMs(f)};
+    for (int r {1}; r < repeats; ++r)
+    {
+        best = std::min(best, measureMs(f));
+    }
+    return best;
+}
+
+template <typename T>
+bool sameMatrix(const Matrix<T>& a, const Matrix<T>& b)
+{
+    if (a.rows() != b.rows() || a.cols() != b.cols())
+    {
+        return false;
+    }
+    for (std::size_t i {0}; i < a.size(); ++i)
+    {
+        if (a.data()[i] != b.data()[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 用法: ./Ex2_matrix_parallel [矩阵边长] [最大线程数]
+int main(int argc, char* argv[])
+{
+    const std::size_t n {argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1024};
+    const std::size_t maxThreads {argc > 2 ? std::strtoul(argv[2], nullptr, 10)
+                                           : std::max(1u, std::thread::hardware_concurrency())};
+
+    Matrix<double> a(n, n);
+    Matrix<double> b(n, n);
+    a.fill([](std::size_t i, std::size_t j) { return static_cast<double>((i + 1) * (j + 1) % 13) * 0.5; });
+    b.fill([](std::size_t i, std::size_t j) { return static_cast<double>((i + 2 * j) % 11) - 5.0; });
+
+    Matrix<double> serial;
+    double serialMs {bestOfMs(3, [&] { serial = multiply(a, b); })};
+    std::cout << n << 'x' << n << " 串行乘法: " << serialMs << " ms\n";
+
+    for (std::size_t threads {1}; threads <= maxThreads; threads *= 2)
+    {
+        ThreadPool pool(threads);
+
+        Matrix<double> filled(n, n);
+        double fillMs {measureMs([&] {
+            parallel::fill(filled, [](std::size_t i, std::size_t j) { return static_cast<double>(i ^ j); }, pool);
+        })};
+
+        Matrix<double> product;
+        double multiplyMs {bestOfMs(3, [&] { product = parallel::multiply(a, b, pool); })};
+
+        Matrix<double> doubled {parallel::transform(product, [](double x) { return x * 2.0; }, pool)};
+
+        std::cout << "线程数 " << threads << ": 填充 " << fillMs << " ms, 乘法 " << multiplyMs
+                  << " ms (加速比 " << serialMs / multiplyMs << "), 结果与串行"
+                  << (sameMatrix(product, serial) ? "逐位一致" : "不一致")
+                  << ", transform 校验 " << (doubled(n - 1, n - 1) == serial(n - 1, n - 1) * 2.0 ? "通过" : "失败")
+                  << '\n';
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm> // std::clamp, std::max
+#include <cstddef>   // std::size_t
+#include <stdexcept> // std::invalid_argument
+
+#include "Ex2_matrix.hpp"
+#include "Ex2_thread_pool.hpp"
+
+// 并行版本的矩阵操作：把行切成若干"行面板" (row panel) 分给线程池。
+// 每一行只由一个块负责写入，每个元素的计算顺序与串行版本完全相同，
+// 所以无论用多少个线程，结果都与串行版本逐位一致。
+namespace parallel
+{
+    // 行面板的高度：块数约为线程数的 4 倍，便于负载均衡；
+    // 同时不超过乘法的行分块，保证每个面板内部依然是完整的缓存分块
+    inline std::size_t panelRows(std::size_t rows, const ThreadPool& pool, std::size_t maxRows)
+    {
+        return std::clamp<std::size_t>(rows / (pool.threadCount() * 4), 1, maxRows);
+    }
+
+    // 按 f(i, j) 并行填充矩阵
+    template <typename T, typename A, typename Func>
+    void fill(Matrix<T, A>& m, Func f, ThreadPool& pool = defaultThreadPool())
+    {
+        const std::size_t cols {m.cols()};
+        pool.parallelFor(0, m.rows(), panelRows(m.rows(), pool, 256),
+                         [&m, &f, cols](std::size_t rowBegin, std::size_t rowEnd)
+                         {
+                             for (std::size_t i {rowBegin}; i < rowEnd; ++i)
+                             {
+                                 T* row {m.rowPtr(i)};
+                                 for (std::size_t j {0}; j < cols; ++j)
+                                 {
+                                     row[j] = static_cast<T>(f(i, j));
+                                 }
+                             }
+                         });
+    }
+
+    // 对每个元素并行地应用 f，返回新矩阵
+    template <typename T, typename A, typename Func>
+    Matrix<T, A> transform(const Matrix<T, A>& a, Func f, ThreadPool& pool = defaultThreadPool())
+    {
+        Matrix<T, A> result(a.rows(), a.cols());
+        const std::size_t cols {a.cols()};
+        pool.parallelFor(0, a.rows(), panelRows(a.rows(), pool, 256),
+                         [&a, &result, &f, cols](std::size_t rowBegin, std::size_t rowEnd)
+                         {
+                             for (std::size_t i {rowBegin}; i < rowEnd; ++i)
+                             {
+                                 const T* src {a.rowPtr(i)};
+                                 T* dst {result.rowPtr(i)};
+                                 for (std::size_t j {0}; j < cols; ++j)
+                                 {
+                                     dst[j] = static_cast<T>(f(src[j]));
+                                 }
+                             }
+                         });
+        return result;
+    }
+
+    // 乘法的行面板高度：每个面板都要把整个 B 从内存读一遍，
+    // 所以面板不能太矮 (只有 kMultiplyTileI 行时 B 的每个分块只被复用 64 次)。
+    // 取 rows / (线程数 * 2) 并向上取整到 kMultiplyTileI 的整数倍，至少一个 kMultiplyTileI：
+    // 每个线程大约两个面板，B 总共只读 2 * 线程数 遍，面板内部依然按 kMultiplyTileI 分块
+    inline std::size_t multiplyPanelRows(std::size_t rows, const ThreadPool& pool)
+    {
+        using MatrixTiling::kMultiplyTileI;
+        const std::size_t target {rows / (pool.threadCount() * 2)};
+        return std::max(kMultiplyTileI, (target + kMultiplyTileI - 1) / kMultiplyTileI * kMultiplyTileI);
+    }
+
+    // 并行分块乘法：每个行面板独立调用串行的 multiplyRows。
+    // B 是只读共享的，各线程写入 C 的不同行，不需要任何锁。
+    template <typename T, typename A>
+    Matrix<T, A> multiply(const Matrix<T, A>& a, const Matrix<T, A>& b, ThreadPool& pool = defaultThreadPool())
+    {
+        if (a.cols() != b.rows())
+        {
+            throw std::invalid_argument("Matrix dimensions do not match for multiply");
+        }
+        Matrix<T, A> result(a.rows(), b.cols());
+        pool.parallelFor(0, a.rows(), multiplyPanelRows(a.rows(), pool),
+                         [&a, &b, &result](std::size_t rowBegin, std::size_t rowEnd)
+                         {
+                             multiplyRows(a, b, result, rowBegin, rowEnd);
+                         });
+        return result;
+    }
+}
@@ -0,0 +1,80 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+
+#include "Ex2_matrix_simd.hpp"
+
+// 方案三中的访问方式：每个元素都做一次边界检查和下标计算
+int& getElement(int* matrix, int rows, int cols, int row, int col)
+{
+    if (row < 0 || row >= rows || col < 0 || col >= cols)
+    {
+        throw std::out_of_range("Index out of bounds");
+    }
+    return matrix[row * cols + col];
+}
+
+std::int64_t sumWithGetElement(Matrix<int>& m)
+{
+    const int rows {static_cast<int>(m.rows())};
+    const int cols {static_cast<int>(m.cols())};
+    std::int64_t total {0};
+    for (int i {0}; i < rows; ++i)
+    {
+        for (int j {0}; j < cols; ++j)
+        {
+            total += getElement(m.data(), rows, cols, i, j);
+        }
+    }
+    return total;
+}
+
+template <typename Func>
+double measureMs(Func f)
+{
+    auto start {std::chrono::steady_clock::now()};
+    f();
+    auto end {std::chrono::steady_clock::now()};
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main()
+{
+    std::cout << "检测到的指令集: " << simd::isaName(simd::detectIsa()) << '\n';
+
+    // 故意选一个不是 8 的倍数的尺寸，检验尾部处理
+    const std::size_t rows {2001};
+    const std::size_t cols {1003};
+    Matrix<int> a(rows, cols);
+    Matrix<int> b(rows, cols);
+    a.fill([](std::size_t i, std::size_t j) { return static_cast<int>((i * 31 + j * 17) % 1000) - 500; });
+    b.fill([](std::size_t i, std::size_t j) { return static_cast<int>((i + 1) * (j + 1) % 97); });
+
+    std::int64_t reference {0};
+    double referenceMs {measureMs([&] { reference = sumWithGetElement(a); })};
+    std::cout << "getElement 求和: " << reference << " (" << referenceMs << " ms)\n\n";
+
+    for (simd::Isa isa : {simd::Isa::Scalar, simd::Isa::SSE42, simd::Isa::AVX2})
+    {
+        simd::useIsa(isa);
+        std::int64_t total {0};
+        double ms {measureMs([&] { total = simd::sum(a); })};
+
+        Matrix<int> sum {simd::add(a, b)};
+        Matrix<int> product {simd::mul(a, b)};
+        Matrix<int> scaled {simd::scale(a, 3)};
+        bool ok {total == reference};
+        for (std::size_t i {0}; i < a.size(); ++i)
+        {
+            ok = ok && sum.data()[i] == a.data()[i] + b.data()[i]
+                    && product.data()[i] == a.data()[i] * b.data()[i]
+                    && scaled.data()[i] == a.data()[i] * 3;
+        }
+
+        std::cout << "[" << simd::isaName(simd::activeIsa()) << "] 求和 " << ms << " ms"
+                  << ", min " << simd::min(a) << ", max " << simd::max(a)
+                  << ", dot " << simd::dot(a, b)
+                  << ", 校验" << (ok ? "通过" : "失败") << '\n';
+    }
+}
@@ -0,0 +1,461 @@
+#pragma once
+
+#include <algorithm> // std::min, std::max
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::int64_t
+#include <stdexcept> // std::invalid_argument
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MATRIX_SIMD_X86 1
+#else
+#define MATRIX_SIMD_X86 0
+#endif
+
+#include "Ex2_matrix.hpp"
+
+// 针对扁平化 int 矩阵 (rows * cols 个连续元素) 的向量化内核。
+// getElement 每访问一个元素都要做一次边界检查和 row * cols + col 的计算；
+// 这里直接把整块数据当作一维数组，一条指令处理 4 (SSE) 或 8 (AVX2) 个 int。
+//
+// 同一个程序可能运行在不同的 CPU 上，所以不在编译期写死指令集，而是：
+// 1. 用 __attribute__((target(...))) 为每个指令集单独编译一份内核
+// 2. 运行时用 __builtin_cpu_supports 检测 CPU，选出对应的函数指针表
+namespace simd
+{
+    enum class Isa
+    {
+        Scalar,
+        SSE42,
+        AVX2,
+    };
+
+    inline const char* isaName(Isa isa)
+    {
+        switch (isa)
+        {
+        case Isa::AVX2: return "AVX2";
+        case Isa::SSE42: return "SSE4.2";
+        default: return "Scalar";
+        }
+    }
+
+    // ---------------- 标量版本 (所有平台都可用，也是其它版本的尾部处理) ----------------
+    namespace scalar
+    {
+        inline void add(const int* a, const int* b, int* out, std::size_t n)
+        {
+            for (std::size_t i {0}; i < n; ++i) out[i] = a[i] + b[i];
+        }
+
+        inline void sub(const int* a, const int* b, int* out, std::size_t n)
+        {
+            for (std::size_t i {0}; i < n; ++i) out[i] = a[i] - b[i];
+        }
+
+        inline void mul(const int* a, const int* b, int* out, std::size_t n)
+        {
+            for (std::size_t i {0}; i < n; ++i) out[i] = a[i] * b[i];
+        }
+
+        inline void scale(const int* a, int s, int* out, std::size_t n)
+        {
+            for (std::size_t i {0}; i < n; ++i) out[i] = a[i] * s;
+        }
+
+        inline std::int64_t sum(const int* a, std::size_t n)
+        {
+            std::int64_t total {0};
+            for (std::size_t i {0}; i < n; ++i) total += a[i];
+            return total;
+        }
+
+        inline int min(const int* a, std::size_t n)
+        {
+            int result {a[0]};
+            for (std::size_t i {1}; i < n; ++i) result = std::min(result, a[i]);
+            return result;
+        }
+
+        inline int max(const int* a, std::size_t n)
+        {
+            int result {a[0]};
+            for (std::size_t i {1}; i < n; ++i) result = std::max(result, a[i]);
+            return result;
+        }
+
+        inline std::int64_t dot(const int* a, const int* b, std::size_t n)
+        {
+            std::int64_t total {0};
+            for (std::size_t i {0}; i < n; ++i) total += static_cast<std::int64_t>(a[i]) * b[i];
+            return total;
+        }
+    }
+
+#if MATRIX_SIMD_X86
+    // ---------------- SSE4.2 版本：每次 4 个 int ----------------
+    namespace sse42
+    {
+        __attribute__((target("sse4.2"))) inline void add(const int* a, const int* b, int* out, std::size_t n)
+        {
+            std::size_t i {0};
+            for (; i + 4 <= n; i += 4)
+            {
+                __m128i va {_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i))};
+                __m128i vb {_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))};
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_add_epi32(va, vb));
+            }
+            scalar::add(a + i, b + i, out + i, n - i);
+        }
+
+        __attribute__((target("sse4.2"))) inline void sub(const int* a, const int* b, int* out, std::size_t n)
+        {
+            std::size_t i {0};
+            for (; i + 4 <= n; i += 4)
+            {
+                __m128i va {_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i))};
+                __m128i vb {_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))};
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_sub_epi32(va, vb));
+            }
+            scalar::sub(a + i, b + i, out + i, n - i);
+        }
+
+        __attribute__((target("sse4.2"))) inline void mul(const int* a, const int* b, int* out, std::size_t n)
+        {
+            std::size_t i {0};
+            for (; i + 4 <= n; i += 4)
+            {
+                __m128i va {_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i))};
+                __m128i vb {_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))};
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_mullo_epi32(va, vb));
+            }
+            scalar::mul(a + i, b + i, out + i, n - i);
+        }
+
+        __attribute__((target("sse4.2"))) inline void scale(const int* a, int s, int* out, std::size_t n)
+        {
+            const __m128i vs {_mm_set1_epi32(s)};
+            std::size_t i {0};
+            for (; i + 4 <= n; i += 4)
+            {
+                __m128i va {_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i))};
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_mullo_epi32(va, vs));
+            }
+            scalar::scale(a + i, s, out + i, n - i);
+        }
+
+        // 求和在 64 位里累加，避免大矩阵上 int 溢出
+        __attribute__((target("sse4.2"))) inline std::int64_t sum(const int* a, std::size_t n)
+        {
+            __m128i acc {_mm_setzero_si128()};
+            std::size_t i {0};
+            for (; i + 4 <= n; i += 4)
+            {
+                __m128i va {_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i))};
+                acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(va));
+                acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(_mm_srli_si128(va, 8)));
+            }
+            alignas(16) std::int64_t lanes[2];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+            return lanes[0] + lanes[1] + scalar::sum(a + i, n - i);
+        }
+
+        __attribute__((target("sse4.2"))) inline int min(const int* a, std::size_t n)
+        {
+            if (n < 4) return scalar::min(a, n);
+            __m128i acc {_mm_loadu_si128(reinterpret_cast<const __m128i*>(a))};
+            std::size_t i {4};
+            for (; i + 4 <= n; i += 4)
+            {
+                acc = _mm_min_epi32(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+            }
+            alignas(16) int lanes[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+            int result {scalar::min(lanes, 4)};
+            return i < n ? std::min(result, scalar::min(a + i, n - i)) : result;
+        }
+
+        __attribute__((target("sse4.2"))) inline int max(const int* a, std::size_t n)
+        {
+            if (n < 4) return scalar::max(a, n);
+            __m128i acc {_mm_loadu_si128(reinterpret_cast<const __m128i*>(a))};
+            std::size_t i {4};
+            for (; i + 4 <= n; i += 4)
+            {
+                acc = _mm_max_epi32(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+            }
+            alignas(16) int lanes[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+            int result {scalar::max(lanes, 4)};
+            return i < n ? std::max(result, scalar::max(a + i, n - i)) : result;
+        }
+
+        // _mm_mul_epi32 只乘偶数通道 (0, 2) 并得到 64 位结果；
+        // 把 64 位通道右移 32 位后再乘一次，就得到奇数通道 (1, 3)
+        __attribute__((target("sse4.2"))) inline std::int64_t dot(const int* a, const int* b, std::size_t n)
+        {
+            __m128i acc {_mm_setzero_si128()};
+            std::size_t i {0};
+            for (; i + 4 <= n; i += 4)
+            {
+                __m128i va {_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i))};
+                __m128i vb {_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))};
+                acc = _mm_add_epi64(acc, _mm_mul_epi32(va, vb));
+                acc = _mm_add_epi64(acc, _mm_mul_epi32(_mm_srli_epi64(va, 32), _mm_srli_epi64(vb, 32)));
+            }
+            alignas(16) std::int64_t lanes[2];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+            return lanes[0] + lanes[1] + scalar::dot(a + i, b + i, n - i);
+        }
+    }
+
+    // ---------------- AVX2 版本：每次 8 个 int ----------------
+    namespace avx2
+    {
+        __attribute__((target("avx2"))) inline void add(const int* a, const int* b, int* out, std::size_t n)
+        {
+            std::size_t i {0};
+            for (; i + 8 <= n; i += 8)
+            {
+                __m256i va {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i))};
+                __m256i vb {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i))};
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi32(va, vb));
+            }
+            scalar::add(a + i, b + i, out + i, n - i);
+        }
+
+        __attribute__((target("avx2"))) inline void sub(const int* a, const int* b, int* out, std::size_t n)
+        {
+            std::size_t i {0};
+            for (; i + 8 <= n; i += 8)
+            {
+                __m256i va {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i))};
+                __m256i vb {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i))};
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_sub_epi32(va, vb));
+            }
+            scalar::sub(a + i, b + i, out + i, n - i);
+        }
+
+        __attribute__((target("avx2"))) inline void mul(const int* a, const int* b, int* out, std::size_t n)
+        {
+            std::size_t i {0};
+            for (; i + 8 <= n; i += 8)
+            {
+                __m256i va {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i))};
+                __m256i vb {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i))};
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_mullo_epi32(va, vb));
+            }
+            scalar::mul(a + i, b + i, out + i, n - i);
+        }
+
+        __attribute__((target("avx2"))) inline void scale(const int* a, int s, int* out, std::size_t n)
+        {
+            const __m256i vs {_mm256_set1_epi32(s)};
+            std::size_t i {0};
+            for (; i + 8 <= n; i += 8)
+            {
+                __m256i va {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i))};
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_mullo_epi32(va, vs));
+            }
+            scalar::scale(a + i, s, out + i, n - i);
+        }
+
+        __attribute__((target("avx2"))) inline std::int64_t sum(const int* a, std::size_t n)
+        {
+            __m256i acc {_mm256_setzero_si256()};
+            std::size_t i {0};
+            for (; i + 8 <= n; i += 8)
+            {
+                __m256i va {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i))};
+                acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(va)));
+                acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(va, 1)));
+            }
+            alignas(32) std::int64_t lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+            return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalar::sum(a + i, n - i);
+        }
+
+        __attribute__((target("avx2"))) inline int min(const int* a, std::size_t n)
+        {
+            if (n < 8) return scalar::min(a, n);
+            __m256i acc {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a))};
+            std::size_t i {8};
+            for (; i + 8 <= n; i += 8)
+            {
+                acc = _mm256_min_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)));
+            }
+            alignas(32) int lanes[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+            int result {scalar::min(lanes, 8)};
+            return i < n ? std::min(result, scalar::min(a + i, n - i)) : result;
+        }
+
+        __attribute__((target("avx2"))) inline int max(const int* a, std::size_t n)
+        {
+            if (n < 8) return scalar::max(a, n);
+            __m256i acc {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a))};
+            std::size_t i {8};
+            for (; i + 8 <= n; i += 8)
+            {
+                acc = _mm256_max_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)));
+            }
+            alignas(32) int lanes[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+            int result {scalar::max(lanes, 8)};
+            return i < n ? std::max(result, scalar::max(a + i, n - i)) : result;
+        }
+
+        __attribute__((target("avx2"))) inline std::int64_t dot(const int* a, const int* b, std::size_t n)
+        {
+            __m256i acc {_mm256_setzero_si256()};
+            std::size_t i {0};
+            for (; i + 8 <= n; i += 8)
+            {
+                __m256i va {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i))};
+                __m256i vb {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i))};
+                acc = _mm256_add_epi64(acc, _mm256_mul_epi32(va, vb));
+                acc = _mm256_add_epi64(acc, _mm256_mul_epi32(_mm256_srli_epi64(va, 32), _mm256_srli_epi64(vb, 32)));
+            }
+            alignas(32) std::int64_t lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+            return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalar::dot(a + i, b + i, n - i);
+        }
+    }
+#endif
+
+    // ---------------- 运行时分发 ----------------
+    struct KernelTable
+    {
+        Isa isa;
+        void (*add)(const int*, const int*, int*, std::size_t);
+        void (*sub)(const int*, const int*, int*, std::size_t);
+        void (*mul)(const int*, const int*, int*, std::size_t);
+        void (*scale)(const int*, int, int*, std::size_t);
+        std::int64_t (*sum)(const int*, std::size_t);
+        int (*min)(const int*, std::size_t);
+        int (*max)(const int*, std::size_t);
+        std::int64_t (*dot)(const int*, const int*, std::size_t);
+    };
+
+    // 当前 CPU 支持的最高指令集
+    inline Isa detectIsa()
+    {
+#if MATRIX_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return Isa::AVX2;
+        if (__builtin_cpu_supports("sse4.2")) return Isa::SSE42;
+#endif
+        return Isa::Scalar;
+    }
+
+    // 取指定指令集的内核表；请求的指令集不被支持时退回到可用的最高一级
+    inline KernelTable kernelsFor(Isa isa)
+    {
+        static const Isa best {detectIsa()};
+        if (static_cast<int>(isa) > static_cast<int>(best))
+        {
+            isa = best;
+        }
+#if MATRIX_SIMD_X86
+        if (isa == Isa::AVX2)
+        {
+            return {Isa::AVX2, avx2::add, avx2::sub, avx2::mul, avx2::scale, avx2::sum, avx2::min, avx2::max, avx2::dot};
+        }
+        if (isa == Isa::SSE42)
+        {
+            return {Isa::SSE42, sse42::add, sse42::sub, sse42::mul, sse42::scale, sse42::sum, sse42::min, sse42::max, sse42::dot};
+        }
+#endif
+        return {Isa::Scalar, scalar::add, scalar::sub, scalar::mul, scalar::scale, scalar::sum, scalar::min, scalar::max, scalar::dot};
+    }
+
+    // 全局使用的内核表，第一次调用时检测 CPU；useIsa 可以强制降级 (用于对比或排查问题)
+    inline KernelTable& activeKernels()
+    {
+        static KernelTable table {kernelsFor(detectIsa())};
+        return table;
+    }
+
+    inline void useIsa(Isa isa)
+    {
+        activeKernels() = kernelsFor(isa);
+    }
+
+    inline Isa activeIsa()
+    {
+        return activeKernels().isa;
+    }
+
+    // ---------------- Matrix<int> 上的封装 ----------------
+    inline void requireSameShape(const Matrix<int>& a, const Matrix<int>& b)
+    {
+        if (a.rows() != b.rows() || a.cols() != b.cols())
+        {
+            throw std::invalid_argument("Matrix dimensions do not match");
+        }
+    }
+
+    inline void requireNonEmpty(const Matrix<int>& a)
+    {
+        if (a.empty())
+        {
+            throw std::invalid_argument("Reduction over an empty matrix");
+        }
+    }
+
+    inline Matrix<int> add(const Matrix<int>& a, const Matrix<int>& b)
+    {
+        requireSameShape(a, b);
+        Matrix<int> result(a.rows(), a.cols());
+        activeKernels().add(a.data(), b.data(), result.data(), a.size());
+        return result;
+    }
+
+    inline Matrix<int> sub(const Matrix<int>& a, const Matrix<int>& b)
+    {
+        requireSameShape(a, b);
+        Matrix<int> result(a.rows(), a.cols());
+        activeKernels().sub(a.data(), b.data(), result.data(), a.size());
+        return result;
+    }
+
+    // 逐元素乘法 (Hadamard 积)，不是矩阵乘法
+    inline Matrix<int> mul(const Matrix<int>& a, const Matrix<int>& b)
+    {
+        requireSameShape(a, b);
+        Matrix<int> result(a.rows(), a.cols());
+        activeKernels().mul(a.data(), b.data(), result.data(), a.size());
+        return result;
+    }
+
+    inline Matrix<int> scale(const Matrix<int>& a, int s)
+    {
+        Matrix<int> result(a.rows(), a.cols());
+        activeKernels().scale(a.data(), s, result.data(), a.size());
+        return result;
+    }
+
+    inline std::int64_t sum(const Matrix<int>& a)
+    {
+        return activeKernels().sum(a.data(), a.size());
+    }
+
+    inline int min(const Matrix<int>& a)
+    {
+        requireNonEmpty(a);
+        return activeKernels().min(a.data(), a.size());
+    }
+
+    inline int max(const Matrix<int>& a)
+    {
+        requireNonEmpty(a);
+        return activeKernels().max(a.data(), a.size());
+    }
+
+    // 把两个矩阵都看作长度为 rows * cols 的向量求点积 (Frobenius 内积)
+    inline std::int64_t dot(const Matrix<int>& a, const Matrix<int>& b)
+    {
+        requireSameShape(a, b);
+        return activeKernels().dot(a.data(), b.data(), a.size());
+    }
+}
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include "Ex2_matrix_transpose.hpp"
+
+// 朴素的双重循环：写入 result(j, i) 时每一步都跨越 rows 个元素
+template <typename T>
+Matrix<T> transposeNaive(const Matrix<T>& a)
+{
+    Matrix<T> result(a.cols(), a.rows());
+    for (std::size_t i {0}; i < a.rows(); ++i)
+    {
+        for (std::size_t j {0}; j < a.cols(); ++j)
+        {
+            result(j, i) = a(i, j);
+        }
+    }
+    return result;
+}
+
+template <typename T>
+bool sameMatrix(const Matrix<T>& a, const Matrix<T>& b)
+{
+    if (a.rows() != b.rows() || a.cols() != b.cols())
+    {
+        return false;
+    }
+    for (std::size_t i {0}; i < a.size(); ++i)
+    {
+        if (a.data()[i] != b.data()[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 重复 5 次取最快的一次，减少偶然的干扰
+template <typename Func>
+double measureMs(Func f)
+{
+    double best {1e300};
+    for (int repeat {0}; repeat < 5; ++repeat)
+    {
+        auto start {std::chrono::steady_clock::now()};
+        f();
+        auto end {std::chrono::steady_clock::now()};
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+template <typename T>
+void compare(std::size_t rows, std::size_t cols)
+{
+    Matrix<T> a(rows, cols);
+    a.fill([](std::size_t i, std::size_t j) { return i * 100003 + j; });
+
+    Matrix<T> naive;
+    Matrix<T> tiled;
+    Matrix<T> fast;
+    double naiveMs {measureMs([&] { naive = transposeNaive(a); })};
+    double tiledMs {measureMs([&] { tiled = transpose(a); })};
+    double fastMs {measureMs([&] { fast = transposeFast(a); })};
+
+    std::cout << rows << 'x' << cols << " (" << sizeof(T) << " 字节元素): 朴素 " << naiveMs
+              << " ms, 分块 " << tiledMs << " ms, 条带+SIMD " << fastMs << " ms, 结果"
+              << (sameMatrix(naive, tiled) && sameMatrix(naive, fast) ? "一致" : "不一致");
+
+    if (rows == cols)
+    {
+        // measureMs 重复奇数次，转置奇数次之后仍然是转置
+        Matrix<T> inPlace {a};
+        double inPlaceMs {measureMs([&] { transposeInPlace(inPlace); })};
+        std::cout << ", 就地 " << inPlaceMs << " ms " << (sameMatrix(naive, inPlace) ? "一致" : "不一致");
+    }
+    std::cout << '\n';
+}
+
+int main()
+{
+    // 8x5：练习中的小矩阵
+    Matrix<int> small(8, 5);
+    small.fill([](std::size_t i, std::size_t j) { return (i + 1) * (j + 1); });
+    Matrix<int> smallT {transposeFast(small)};
+    for (std::size_t i {0}; i < smallT.rows(); ++i)
+    {
+        for (std::size_t j {0}; j < smallT.cols(); ++j)
+        {
+            std::cout << smallT(i, j) << (j != smallT.cols() - 1 ? ' ' : '\n');
+        }
+    }
+    std::cout << '\n';
+
+    compare<int>(100, 37);     // 非 8 的倍数，检验边角处理
+    compare<int>(203, 203);
+    compare<int>(2048, 2048);  // 2 的幂：朴素版本的缓存组冲突最严重
+    compare<int>(3000, 1700);
+    compare<double>(2048, 2048);
+}
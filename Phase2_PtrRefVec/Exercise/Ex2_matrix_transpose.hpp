@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm> // std::min, std::max
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::int32_t
+#include <stdexcept> // std::invalid_argument
+#include <utility>   // std::swap
+
+#include "Ex2_matrix.hpp"
+#include "Ex2_matrix_simd.hpp" // MATRIX_SIMD_X86, simd::Isa, simd::detectIsa
+
+// 转置内核：
+// - 朴素的双重循环写入时每一步都跨越 rows 个元素，几乎每次都缓存未命中
+// - 非就地转置按条带处理：每次取源矩阵的一条缓存行那么多行 (int 是 16 行，double 是 8 行)，
+//   再按 kTransposeLeaf 列一块从左到右走完整个宽度。
+//   源矩阵是十几路顺序读，硬件预取跟得上；一条带结束时，结果中被写到的每条缓存行都恰好写满，
+//   之后不会再被碰到。
+//   之前的缓存无关递归 (叶子 64x64) 在 3000x1700 的 int 矩阵上比朴素版本还慢：
+//   叶子之间切换时，写了一半的缓存行和 TLB 项都要重新载入。换成条带后，int 矩阵在各种形状上
+//   都比朴素版本快 1.5 ~ 4 倍，double 矩阵 (没有 SIMD 内核) 与原来的递归持平
+// - 条带内部按 8x8 处理：对 32 位元素用 AVX2 在寄存器里完成 8x8 转置，
+//   读入 8 行、写出 8 行，全部是连续的 32 字节访问
+// - 方阵就地转置仍然用递归：对角线两侧的块必须成对交换，递归切分最自然
+namespace transpose_detail
+{
+    constexpr std::size_t kCacheLine {64};
+    constexpr std::size_t kTransposeLeaf {64};
+
+    // 标量 8x8 (或不足 8x8 的边角) 块：dst[j][i] = src[i][j]
+    template <typename T>
+    inline void blockScalar(const T* src, std::size_t srcStride, T* dst, std::size_t dstStride,
+                            std::size_t rows, std::size_t cols)
+    {
+        for (std::size_t i {0}; i < rows; ++i)
+        {
+            for (std::size_t j {0}; j < cols; ++j)
+            {
+                dst[j * dstStride + i] = src[i * srcStride + j];
+            }
+        }
+    }
+
+#if MATRIX_SIMD_X86
+    // 经典的 unpack + shuffle + permute2x128 三步：
+    // 1. unpacklo/hi_epi32 交错相邻两行的 32 位元素
+    // 2. shuffle_ps 组合出每 4 个一组的列
+    // 3. permute2f128 交换两个 128 位半边
+    __attribute__((target("avx2"))) inline void block8x8Avx2(const std::int32_t* src, std::size_t srcStride,
+                                                             std::int32_t* dst, std::size_t dstStride)
+    {
+        __m256 r0 {_mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 0 * srcStride)))};
+        __m256 r1 {_mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 1 * srcStride)))};
+        __m256 r2 {_mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 2 * srcStride)))};
+        __m256 r3 {_mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 3 * srcStride)))};
+        __m256 r4 {_mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * srcStride)))};
+        __m256 r5 {_mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 5 * srcStride)))};
+        __m256 r6 {_mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 6 * srcStride)))};
+        __m256 r7 {_mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 7 * srcStride)))};
+
+        __m256 t0 {_mm256_unpacklo_ps(r0, r1)};
+        __m256 t1 {_mm256_unpackhi_ps(r0, r1)};
+        __m256 t2 {_mm256_unpacklo_ps(r2, r3)};
+        __m256 t3 {_mm256_unpackhi_ps(r2, r3)};
+        __m256 t4 {_mm256_unpacklo_ps(r4, r5)};
+        __m256 t5 {_mm256_unpackhi_ps(r4, r5)};
+        __m256 t6 {_mm256_unpacklo_ps(r6, r7)};
+        __m256 t7 {_mm256_unpackhi_ps(r6, r7)};
+
+        __m256 s0 {_mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0))};
+        __m256 s1 {_mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2))};
+        __m256 s2 {_mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0))};
+        __m256 s3 {_mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2))};
+        __m256 s4 {_mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0))};
+        __m256 s5 {_mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2))};
+        __m256 s6 {_mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0))};
+        __m256 s7 {_mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2))};
+
+        __m256 out[8] {
+            _mm256_permute2f128_ps(s0, s4, 0x20), _mm256_permute2f128_ps(s1, s5, 0x20),
+            _mm256_permute2f128_ps(s2, s6, 0x20), _mm256_permute2f128_ps(s3, s7, 0x20),
+            _mm256_permute2f128_ps(s0, s4, 0x31), _mm256_permute2f128_ps(s1, s5, 0x31),
+            _mm256_permute2f128_ps(s2, s6, 0x31), _mm256_permute2f128_ps(s3, s7, 0x31),
+        };
+        for (std::size_t row {0}; row < 8; ++row)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + row * dstStride), _mm256_castps_si256(out[row]));
+        }
+    }
+#endif
+
+    inline bool useAvx2()
+    {
+        static const bool available {simd::detectIsa() == simd::Isa::AVX2};
+        return available;
+    }
+
+    // 叶子块：整 8x8 的部分交给 SIMD (仅 32 位元素)，边角用标量
+    template <typename T>
+    void leaf(const T* src, std::size_t srcStride, T* dst, std::size_t dstStride,
+              std::size_t rows, std::size_t cols)
+    {
+#if MATRIX_SIMD_X86
+        if constexpr (sizeof(T) == 4)
+        {
+            if (useAvx2())
+            {
+                const std::size_t fullRows {rows & ~std::size_t {7}};
+                const std::size_t fullCols {cols & ~std::size_t {7}};
+                for (std::size_t i {0}; i < fullRows; i += 8)
+                {
+                    for (std::size_t j {0}; j < fullCols; j += 8)
+                    {
+                        block8x8Avx2(reinterpret_cast<const std::int32_t*>(src + i * srcStride + j), srcStride,
+                                     reinterpret_cast<std::int32_t*>(dst + j * dstStride + i), dstStride);
+                    }
+                }
+                // 右侧剩余的列 和 底部剩余的行
+                blockScalar(src + fullCols, srcStride, dst + fullCols * dstStride, dstStride, fullRows, cols - fullCols);
+                blockScalar(src + fullRows * srcStride, srcStride, dst + fullRows, dstStride, rows - fullRows, cols);
+                return;
+            }
+        }
+#endif
+        blockScalar(src, srcStride, dst, dstStride, rows, cols);
+    }
+
+    // 非就地转置：源矩阵每 kCacheLine / sizeof(T) 行为一条带，条带内每 kTransposeLeaf 列交给一次 leaf
+    template <typename T>
+    void strips(const T* src, std::size_t srcStride, T* dst, std::size_t dstStride,
+                std::size_t rows, std::size_t cols)
+    {
+        constexpr std::size_t strip {std::max<std::size_t>(kCacheLine / sizeof(T), 1)};
+        for (std::size_t i {0}; i < rows; i += strip)
+        {
+            const std::size_t stripRows {std::min(strip, rows - i)};
+            for (std::size_t j {0}; j < cols; j += kTransposeLeaf)
+            {
+                leaf(src + i * srcStride + j, srcStride, dst + j * dstStride + i, dstStride, stripRows,
+                     std::min(kTransposeLeaf, cols - j));
+            }
+        }
+    }
+
+    // 方阵就地转置中，区域 [i0, i0+rows) x [j0, j0+cols) 与它关于对角线的镜像互换并转置。
+    // 完整的 8x8 块借助栈上的临时块走 leaf (可以用上 SIMD)，边角逐元素交换。
+    template <typename T>
+    void swapBlocks(T* a, std::size_t n, std::size_t i0, std::size_t j0, std::size_t rows, std::size_t cols)
+    {
+        const std::size_t fullRows {rows & ~std::size_t {7}};
+        const std::size_t fullCols {cols & ~std::size_t {7}};
+        T tmp[64];
+        for (std::size_t i {i0}; i < i0 + fullRows; i += 8)
+        {
+            for (std::size_t j {j0}; j < j0 + fullCols; j += 8)
+            {
+                T* upper {a + i * n + j};
+                T* lower {a + j * n + i};
+                leaf(upper, n, tmp, 8, 8, 8);
+                leaf(lower, n, upper, n, 8, 8);
+                for (std::size_t r {0}; r < 8; ++r)
+                {
+                    for (std::size_t c {0}; c < 8; ++c)
+                    {
+                        lower[r * n + c] = tmp[r * 8 + c];
+                    }
+                }
+            }
+        }
+        for (std::size_t i {i0}; i < i0 + rows; ++i)
+        {
+            // 完整块覆盖的行只剩右侧的边角列，其余行整行都要处理
+            const std::size_t jBegin {i < i0 + fullRows ? j0 + fullCols : j0};
+            for (std::size_t j {jBegin}; j < j0 + cols; ++j)
+            {
+                std::swap(a[i * n + j], a[j * n + i]);
+            }
+        }
+    }
+
+    // 就地转置的递归：对角线上的块递归转置自身，非对角的一对块 (上方与其镜像) 互相交换转置
+    template <typename T>
+    void recurseSquareOffDiagonal(T* a, std::size_t n, std::size_t i0, std::size_t j0,
+                                  std::size_t rows, std::size_t cols)
+    {
+        if (rows <= kTransposeLeaf && cols <= kTransposeLeaf)
+        {
+            swapBlocks(a, n, i0, j0, rows, cols);
+            return;
+        }
+        if (rows >= cols)
+        {
+            std::size_t half {(rows / 2 + 7) & ~std::size_t {7}};
+            recurseSquareOffDiagonal(a, n, i0, j0, half, cols);
+            recurseSquareOffDiagonal(a, n, i0 + half, j0, rows - half, cols);
+        }
+        else
+        {
+            std::size_t half {(cols / 2 + 7) & ~std::size_t {7}};
+            recurseSquareOffDiagonal(a, n, i0, j0, rows, half);
+            recurseSquareOffDiagonal(a, n, i0, j0 + half, rows, cols - half);
+        }
+    }
+
+    template <typename T>
+    void recurseSquareDiagonal(T* a, std::size_t n, std::size_t begin, std::size_t size)
+    {
+        if (size <= kTransposeLeaf)
+        {
+            for (std::size_t i {begin}; i < begin + size; ++i)
+            {
+                for (std::size_t j {i + 1}; j < begin + size; ++j)
+                {
+                    std::swap(a[i * n + j], a[j * n + i]);
+                }
+            }
+            return;
+        }
+        std::size_t half {(size / 2 + 7) & ~std::size_t {7}};
+        recurseSquareDiagonal(a, n, begin, half);
+        recurseSquareDiagonal(a, n, begin + half, size - half);
+        // 右上角块 [begin, begin+half) x [begin+half, begin+size) 与左下角块互换
+        recurseSquareOffDiagonal(a, n, begin, begin + half, half, size - half);
+    }
+}
+
+// 非就地转置，适用于任意形状：按缓存行分条带 + 8x8 SIMD 块
+template <typename T>
+Matrix<T> transposeFast(const Matrix<T>& a)
+{
+    Matrix<T> result(a.cols(), a.rows());
+    if (!a.empty())
+    {
+        transpose_detail::strips(a.data(), a.cols(), result.data(), result.cols(), a.rows(), a.cols());
+    }
+    return result;
+}
+
+// 方阵就地转置：不需要额外的 rows * cols 缓冲区
+template <typename T>
+void transposeInPlace(Matrix<T>& a)
+{
+    if (a.rows() != a.cols())
+    {
+        throw std::invalid_argument("In-place transpose requires a square matrix");
+    }
+    if (!a.empty())
+    {
+        transpose_detail::recurseSquareDiagonal(a.data(), a.rows(), 0, a.rows());
+    }
+}
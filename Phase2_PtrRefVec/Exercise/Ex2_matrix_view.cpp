@@ -0,0 +1,201 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+
+#include "Ex2_matrix_view.hpp"
+
+// 取 5 次中最快的一次，减少偶然的干扰
+template <typename Func>
+double measureMs(Func f)
+{
+    double best {1e300};
+    for (int run {0}; run < 5; ++run)
+    {
+        auto start {std::chrono::steady_clock::now()};
+        f();
+        auto end {std::chrono::steady_clock::now()};
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+// 方案三的 getElement：每次访问都做边界检查
+int& getElement(int* matrix, int rows, int cols, int row, int col)
+{
+    if (row < 0 || row >= rows || col < 0 || col >= cols)
+    {
+        throw std::out_of_range("Index out of bounds");
+    }
+    return matrix[row * cols + col];
+}
+
+// 方案三的写法：每个元素都通过 getElement 访问
+long long sumGetElement(int* matrix, int rows, int cols)
+{
+    long long total {0};
+    for (int i {0}; i < rows; ++i)
+    {
+        for (int j {0}; j < cols; ++j)
+        {
+            total += getElement(matrix, rows, cols, i, j);
+        }
+    }
+    return total;
+}
+
+// 每个元素都通过 v(i, j) 访问：CheckedAccess 时每次都检查行号和列号
+template <typename View>
+long long sumView(const View& v)
+{
+    long long total {0};
+    for (std::size_t i {0}; i < v.rows(); ++i)
+    {
+        for (std::size_t j {0}; j < v.cols(); ++j)
+        {
+            total += v(i, j);
+        }
+    }
+    return total;
+}
+
+// 逐行访问：row(i) 检查一次行号，行内用迭代器 (裸指针) 遍历 [begin, end)，不可能越界，也就不需要再检查。
+// 检查从内层循环提到了外层，CheckedAccess 的视图也和不检查的一样快
+template <typename View>
+long long sumRows(const View& v)
+{
+    long long total {0};
+    for (std::size_t i {0}; i < v.rows(); ++i)
+    {
+        for (auto value : v.row(i))
+        {
+            total += value;
+        }
+    }
+    return total;
+}
+
+int main(int argc, char* argv[])
+{
+    // 1. 练习中的 8x5：按行视图用 range-for 打印
+    Matrix<int> m(8, 5);
+    m.fill([](std::size_t i, std::size_t j) { return (i + 1) * (j + 1); });
+    auto v {view(m)};
+    for (std::size_t i {0}; i < v.rows(); ++i)
+    {
+        for (int value : v.row(i))
+        {
+            std::cout << value << ' ';
+        }
+        std::cout << '\n';
+    }
+
+    // 2. 列视图配合标准算法
+    std::cout << "第 3 列之和: " << std::accumulate(v.col(2).begin(), v.col(2).end(), 0) << '\n';
+    auto column {v.col(4)};
+    std::reverse(column.begin(), column.end());
+    std::cout << "反转第 5 列后: ";
+    for (int value : column)
+    {
+        std::cout << value << ' ';
+    }
+    std::cout << "\n最大值所在行: " << std::max_element(column.begin(), column.end()) - column.begin() << '\n';
+
+    // 3. 子矩阵：把中间 4x3 的区域清零，子矩阵与原矩阵共享数据
+    auto middle {v.submatrix(2, 1, 4, 3)};
+    for (std::size_t i {0}; i < middle.rows(); ++i)
+    {
+        std::fill(middle.row(i).begin(), middle.row(i).end(), 0);
+    }
+    std::cout << "\n中间 4x3 清零后:\n";
+    for (std::size_t i {0}; i < m.rows(); ++i)
+    {
+        for (int value : rowView(m, i))
+        {
+            std::cout << value << ' ';
+        }
+        std::cout << '\n';
+    }
+
+    // 4. 检查策略：CheckedAccess 越界抛异常；包装方案三的裸 int* 数组
+    int flat[8 * 5] {};
+    MatrixView<int, CheckedAccess> checked {flat, 8, 5};
+    try
+    {
+        checked(8, 0) = 1;
+    }
+    catch (const std::out_of_range& e)
+    {
+        std::cout << "\nCheckedAccess 访问 (8, 0): " << e.what() << '\n';
+    }
+    try
+    {
+        checked.submatrix(6, 0, 3, 5);
+    }
+    catch (const std::out_of_range& e)
+    {
+        std::cout << "submatrix(6, 0, 3, 5): " << e.what() << '\n';
+    }
+#ifdef NDEBUG
+    std::cout << "当前为发布构建 (NDEBUG)，DefaultAccess = UncheckedAccess\n";
+#else
+    std::cout << "当前为调试构建，DefaultAccess = CheckedAccess\n";
+#endif
+
+    // 5. 性能：getElement vs 检查的视图 (逐元素 / 逐行) vs 不检查的视图。
+    //    用 256x256 (256 KB，在 L2 中) 重复求和，避免测量结果被内存带宽掩盖；n 从命令行读取，防止编译器按常量优化。
+    //    像这样简单的循环，优化器往往能证明 v(i, j) 的检查永远不会失败并把它删掉，但这取决于内联的结果，
+    //    代码稍有改动时逐元素检查曾经比 getElement 慢 2 倍多。
+    //    热循环里应该逐行访问 (sumRows)：检查每行只做一次，不依赖优化器，CheckedAccess 也不比 UncheckedAccess 慢；
+    //    需要随机访问 (i, j) 时，在确认过范围的循环外面用 withAccess<UncheckedAccess>() 切换，
+    //    UncheckedAccess 保证在任何情况下都只剩下指针运算
+    const int n {argc > 1 ? std::atoi(argv[1]) : 256};
+    const int repeats {200};
+    Matrix<int> plain(n, n);
+    plain.fill([](std::size_t i, std::size_t j) { return static_cast<int>((i + j) % 10); });
+
+    long long getElementSum {0};
+    double getElementMs {measureMs(
+        [&]
+        {
+            for (int r {0}; r < repeats; ++r)
+            {
+                getElementSum += sumGetElement(plain.data(), n, n);
+            }
+        })};
+    long long checkedSum {0};
+    double checkedMs {measureMs(
+        [&]
+        {
+            for (int r {0}; r < repeats; ++r)
+            {
+                checkedSum += sumView(view<CheckedAccess>(plain));
+            }
+        })};
+    long long checkedRowsSum {0};
+    double checkedRowsMs {measureMs(
+        [&]
+        {
+            for (int r {0}; r < repeats; ++r)
+            {
+                checkedRowsSum += sumRows(view<CheckedAccess>(plain));
+            }
+        })};
+    long long uncheckedSum {0};
+    double uncheckedMs {measureMs(
+        [&]
+        {
+            for (int r {0}; r < repeats; ++r)
+            {
+                uncheckedSum += sumView(view<UncheckedAccess>(plain));
+            }
+        })};
+
+    std::cout << "\n" << n << 'x' << n << " 求和 " << repeats << " 次:\n";
+    std::cout << "getElement                         : " << getElementMs << " ms (" << getElementSum << ")\n";
+    std::cout << "MatrixView<CheckedAccess> (i, j)   : " << checkedMs << " ms (" << checkedSum << ")\n";
+    std::cout << "MatrixView<CheckedAccess> 逐行     : " << checkedRowsMs << " ms (" << checkedRowsSum << ")\n";
+    std::cout << "MatrixView<UncheckedAccess> (i, j) : " << uncheckedMs << " ms (" << uncheckedSum << ")\n";
+    return 0;
+}
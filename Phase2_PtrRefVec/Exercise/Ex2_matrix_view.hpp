@@ -0,0 +1,236 @@
+#pragma once
+
+#include <cstddef>     // std::size_t, std::ptrdiff_t
+#include <iterator>    // std::random_access_iterator_tag
+#include <stdexcept>   // std::out_of_range
+#include <type_traits> // std::remove_cv_t
+
+#include "Ex2_matrix.hpp"
+
+// 行视图、列视图和带步长的子矩阵视图：只保存指针、长度和步长，不拥有也不拷贝数据，
+// 可以按值传递，可以用在 range-for 和标准算法中 (std::accumulate、std::sort ...)。
+//
+// 方案三的 getElement 每次访问都做边界检查，调试时很有用，但在热循环里是纯粹的开销。
+// 这里把检查做成模板参数 (访问策略)：
+//   CheckedAccess    越界时抛 std::out_of_range，与 getElement 相同
+//   UncheckedAccess  空函数，编译后就是裸指针运算
+// 默认策略 DefaultAccess 跟随 NDEBUG：调试构建检查，发布构建 (-DNDEBUG) 不检查。
+// 创建视图 (row / col / submatrix) 时总是检查范围，那不在热循环里。
+// 所以热循环里最好逐行遍历：for (auto x : v.row(i)) 每行只检查一次行号，行内是裸指针，
+// CheckedAccess 也不会在内层循环留下任何检查；v(i, j) 则每次访问都检查行号和列号。
+struct CheckedAccess
+{
+    static void check(std::size_t index, std::size_t size)
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("Index out of bounds");
+        }
+    }
+};
+
+struct UncheckedAccess
+{
+    static void check(std::size_t /*index*/, std::size_t /*size*/) noexcept {}
+};
+
+#ifdef NDEBUG
+using DefaultAccess = UncheckedAccess;
+#else
+using DefaultAccess = CheckedAccess;
+#endif
+
+// 每次前进 stride 个元素的随机访问迭代器 (用于列视图)。
+// 保存起始指针和下标，而不是直接移动指针：列的 end() 是下标 size，
+// 如果写成指针就是 data + j + rows * stride，对 j > 0 的列已经越过了数组末尾的下一个位置，
+// 即使不解引用，计算出这样的指针也是未定义行为。只有解引用时才计算真正的地址。
+template <typename T>
+class StridedIterator
+{
+private:
+    T* base_ {nullptr};
+    std::ptrdiff_t index_ {0};
+    std::ptrdiff_t stride_ {1};
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    StridedIterator() = default;
+    StridedIterator(T* base, std::ptrdiff_t index, std::ptrdiff_t stride) : base_{base}, index_{index}, stride_{stride} {}
+
+    reference operator*() const { return base_[index_ * stride_]; }
+    pointer operator->() const { return base_ + index_ * stride_; }
+    reference operator[](difference_type n) const { return base_[(index_ + n) * stride_]; }
+
+    StridedIterator& operator++() { ++index_; return *this; }
+    StridedIterator operator++(int) { StridedIterator old {*this}; ++index_; return old; }
+    StridedIterator& operator--() { --index_; return *this; }
+    StridedIterator operator--(int) { StridedIterator old {*this}; --index_; return old; }
+    StridedIterator& operator+=(difference_type n) { index_ += n; return *this; }
+    StridedIterator& operator-=(difference_type n) { index_ -= n; return *this; }
+
+    friend StridedIterator operator+(StridedIterator it, difference_type n) { return it += n; }
+    friend StridedIterator operator+(difference_type n, StridedIterator it) { return it += n; }
+    friend StridedIterator operator-(StridedIterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const StridedIterator& a, const StridedIterator& b) { return a.index_ - b.index_; }
+
+    // 只比较同一列上的迭代器，所以只需要比较下标
+    friend bool operator==(const StridedIterator& a, const StridedIterator& b) { return a.index_ == b.index_; }
+    friend bool operator!=(const StridedIterator& a, const StridedIterator& b) { return a.index_ != b.index_; }
+    friend bool operator<(const StridedIterator& a, const StridedIterator& b) { return a.index_ < b.index_; }
+    friend bool operator>(const StridedIterator& a, const StridedIterator& b) { return b < a; }
+    friend bool operator<=(const StridedIterator& a, const StridedIterator& b) { return !(b < a); }
+    friend bool operator>=(const StridedIterator& a, const StridedIterator& b) { return !(a < b); }
+};
+
+// 一行：连续的 size 个元素，迭代器就是裸指针。T 为 const int 时是只读视图
+template <typename T, typename Access = DefaultAccess>
+class RowView
+{
+private:
+    T* data_;
+    std::size_t size_;
+
+public:
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    RowView(T* data, std::size_t size) : data_{data}, size_{size} {}
+
+    std::size_t size() const { return size_; }
+    T* data() const { return data_; }
+    iterator begin() const { return data_; }
+    iterator end() const { return data_ + size_; }
+
+    T& operator[](std::size_t i) const
+    {
+        Access::check(i, size_);
+        return data_[i];
+    }
+};
+
+// 一列：相邻元素相距 stride 个元素
+template <typename T, typename Access = DefaultAccess>
+class ColumnView
+{
+private:
+    T* data_;
+    std::size_t size_;
+    std::size_t stride_;
+
+public:
+    using value_type = std::remove_cv_t<T>;
+    using iterator = StridedIterator<T>;
+
+    ColumnView(T* data, std::size_t size, std::size_t stride) : data_{data}, size_{size}, stride_{stride} {}
+
+    std::size_t size() const { return size_; }
+    std::size_t stride() const { return stride_; }
+    iterator begin() const { return iterator(data_, 0, static_cast<std::ptrdiff_t>(stride_)); }
+    iterator end() const { return iterator(data_, static_cast<std::ptrdiff_t>(size_), static_cast<std::ptrdiff_t>(stride_)); }
+
+    T& operator[](std::size_t i) const
+    {
+        Access::check(i, size_);
+        return data_[i * stride_];
+    }
+};
+
+// 矩阵或子矩阵：rows x cols 个元素，第 i 行从 data + i * stride 开始。
+// 可以引用 Matrix 的一部分，也可以直接包装方案三的 int* 数组
+template <typename T, typename Access = DefaultAccess>
+class MatrixView
+{
+private:
+    T* data_;
+    std::size_t rows_;
+    std::size_t cols_;
+    std::size_t stride_;
+
+public:
+    using value_type = std::remove_cv_t<T>;
+
+    MatrixView(T* data, std::size_t rows, std::size_t cols, std::size_t stride)
+        : data_{data}, rows_{rows}, cols_{cols}, stride_{stride}
+    {
+    }
+
+    MatrixView(T* data, std::size_t rows, std::size_t cols) : MatrixView(data, rows, cols, cols) {}
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    std::size_t stride() const { return stride_; }
+    T* data() const { return data_; }
+    T* rowPtr(std::size_t row) const { return data_ + row * stride_; }
+
+    T& operator()(std::size_t row, std::size_t col) const
+    {
+        Access::check(row, rows_);
+        Access::check(col, cols_);
+        return data_[row * stride_ + col];
+    }
+
+    RowView<T, Access> row(std::size_t i) const
+    {
+        CheckedAccess::check(i, rows_);
+        return RowView<T, Access>(data_ + i * stride_, cols_);
+    }
+
+    ColumnView<T, Access> col(std::size_t j) const
+    {
+        CheckedAccess::check(j, cols_);
+        return ColumnView<T, Access>(data_ + j, rows_, stride_);
+    }
+
+    // 左上角为 (row, col) 的 rows x cols 子矩阵，步长不变
+    MatrixView submatrix(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) const
+    {
+        if (row > rows_ || col > cols_ || rows > rows_ - row || cols > cols_ - col)
+        {
+            throw std::out_of_range("Submatrix out of bounds");
+        }
+        return MatrixView(data_ + row * stride_ + col, rows, cols, stride_);
+    }
+
+    // 换一种访问策略，例如在确认过范围的循环外面切换成不检查的视图
+    template <typename OtherAccess>
+    MatrixView<T, OtherAccess> withAccess() const
+    {
+        return MatrixView<T, OtherAccess>(data_, rows_, cols_, stride_);
+    }
+
+    // 只读视图
+    operator MatrixView<const T, Access>() const
+    {
+        return MatrixView<const T, Access>(data_, rows_, cols_, stride_);
+    }
+};
+
+// 从 Matrix 创建视图；Matrix 是 const 时得到只读视图
+template <typename Access = DefaultAccess, typename T, typename A>
+MatrixView<T, Access> view(Matrix<T, A>& m)
+{
+    return MatrixView<T, Access>(m.data(), m.rows(), m.cols(), m.stride());
+}
+
+template <typename Access = DefaultAccess, typename T, typename A>
+MatrixView<const T, Access> view(const Matrix<T, A>& m)
+{
+    return MatrixView<const T, Access>(m.data(), m.rows(), m.cols(), m.stride());
+}
+
+template <typename Access = DefaultAccess, typename M>
+auto rowView(M& m, std::size_t i)
+{
+    return view<Access>(m).row(i);
+}
+
+template <typename Access = DefaultAccess, typename M>
+auto colView(M& m, std::size_t j)
+{
+    return view<Access>(m).col(j);
+}
@@ -0,0 +1,79 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "Ex2_sparse_matrix.hpp"
+
+template <typename Func>
+double measureMs(Func f)
+{
+    auto start {std::chrono::steady_clock::now()};
+    f();
+    auto end {std::chrono::steady_clock::now()};
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main()
+{
+    // 1. 小例子：8x5 的矩阵里只有对角线附近有值
+    Matrix<int> dense(8, 5);
+    dense.fill([](std::size_t i, std::size_t j) { return i % 5 == j ? static_cast<int>((i + 1) * (j + 1)) : 0; });
+    CsrMatrix<int> small {CsrMatrix<int>::fromDense(dense)};
+
+    std::cout << "非零元素: " << small.nonZeros() << "\nrowOffsets:";
+    for (std::size_t offset : small.rowOffsets()) std::cout << ' ' << offset;
+    std::cout << "\ncolIndices:";
+    for (std::uint32_t col : small.colIndices()) std::cout << ' ' << col;
+    std::cout << "\nvalues:    ";
+    for (int value : small.values()) std::cout << ' ' << value;
+    std::cout << "\n\n";
+
+    // 2. 大例子：4096x4096，每行约 20 个非零 (稀疏度 99.5%)，用无序 COO 三元组构建，包含重复项
+    const std::size_t n {4096};
+    std::vector<Triplet<double>> triplets;
+    std::uint64_t state {12345};
+    auto nextRandom = [&state] {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return state >> 33;
+    };
+    for (std::size_t k {0}; k < n * 20; ++k)
+    {
+        triplets.push_back({nextRandom() % n, nextRandom() % n, static_cast<double>(nextRandom() % 9) + 1.0});
+    }
+    CsrMatrix<double> a {CsrMatrix<double>::fromTriplets(n, n, triplets)};
+    Matrix<double> aDense {a.toDense()};
+
+    std::cout << n << 'x' << n << " 矩阵: 非零 " << a.nonZeros() << ", CSR 占用 " << a.memoryBytes() / 1024
+              << " KB, 稠密占用 " << aDense.size() * sizeof(double) / 1024 << " KB\n";
+
+    std::vector<double> x(n);
+    for (std::size_t i {0}; i < n; ++i) x[i] = static_cast<double>(i % 7) - 3.0;
+
+    // 稠密的矩阵向量乘法作为参照
+    std::vector<double> reference(n, 0.0);
+    double denseMs {measureMs([&] {
+        for (std::size_t i {0}; i < n; ++i)
+        {
+            double sum {0.0};
+            for (std::size_t j {0}; j < n; ++j) sum += aDense(i, j) * x[j];
+            reference[i] = sum;
+        }
+    })};
+
+    std::vector<double> y;
+    double sparseMs {measureMs([&] { y = spmv(a, x); })};
+    bool same {y == reference};
+    std::cout << "矩阵 x 向量: 稠密 " << denseMs << " ms, SpMV " << sparseMs << " ms, 结果"
+              << (same ? "一致" : "不一致") << '\n';
+
+    // 稀疏 x 稠密
+    Matrix<double> b(n, 64);
+    b.fill([](std::size_t i, std::size_t j) { return static_cast<double>((i + j) % 5); });
+    Matrix<double> c;
+    double spmmMs {measureMs([&] { c = spmm(a, b); })};
+    Matrix<double> cReference {multiply(aDense, b)};
+    bool sameC {true};
+    for (std::size_t k {0}; k < c.size(); ++k) sameC = sameC && c.data()[k] == cReference.data()[k];
+    std::cout << "稀疏 x 稠密 (" << n << "x64): " << spmmMs << " ms, 结果" << (sameC ? "一致" : "不一致") << '\n';
+}
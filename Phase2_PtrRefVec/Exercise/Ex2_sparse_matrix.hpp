@@ -0,0 +1,283 @@
+#pragma once
+
+#include <algorithm> // std::sort, std::lower_bound, std::min
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::uint32_t
+#include <limits>    // std::numeric_limits
+#include <stdexcept> // std::invalid_argument, std::out_of_range
+#include <utility>   // std::move
+#include <vector>    // std::vector
+
+#include "Ex2_matrix.hpp"
+#include "Ex2_thread_pool.hpp"
+
+// 稀疏矩阵：绝大多数元素是 0 时，只存非零元素。
+//
+// COO (coordinate) 格式：一串 (row, col, value) 三元组，方便逐个追加，适合作为输入。
+// CSR (compressed sparse row) 格式：
+//   values_[k]      第 k 个非零元素的值 (按行、行内按列排列)
+//   colIndices_[k]  第 k 个非零元素所在的列
+//   rowOffsets_[i]  第 i 行的第一个非零元素在 values_ 中的下标，共 rows + 1 项，
+//                   第 i 行的非零元素就是 [rowOffsets_[i], rowOffsets_[i + 1])
+// 一个 99% 为零的 4096x4096 double 矩阵，稠密存储 128 MB，CSR 只需约 2 MB。
+template <typename T>
+struct Triplet
+{
+    std::size_t row;
+    std::size_t col;
+    T value;
+};
+
+template <typename T>
+class CsrMatrix
+{
+private:
+    std::size_t rows_ {0};
+    std::size_t cols_ {0};
+    std::vector<std::size_t> rowOffsets_;
+    std::vector<std::uint32_t> colIndices_; // 32 位列号，每个非零元素省下 4 字节
+    std::vector<T> values_;
+
+    static void checkCols(std::size_t cols)
+    {
+        if (cols > std::numeric_limits<std::uint32_t>::max())
+        {
+            throw std::invalid_argument("CsrMatrix supports at most 2^32 - 1 columns");
+        }
+    }
+
+public:
+    CsrMatrix() : rowOffsets_(1, 0) {}
+
+    // 从稠密的扁平矩阵构建：按行扫描，跳过所有 0
+    static CsrMatrix fromDense(const Matrix<T>& dense)
+    {
+        checkCols(dense.cols());
+        CsrMatrix result;
+        result.rows_ = dense.rows();
+        result.cols_ = dense.cols();
+        result.rowOffsets_.assign(dense.rows() + 1, 0);
+        for (std::size_t i {0}; i < dense.rows(); ++i)
+        {
+            const T* row {dense.rowPtr(i)};
+            for (std::size_t j {0}; j < dense.cols(); ++j)
+            {
+                if (row[j] != T {})
+                {
+                    result.colIndices_.push_back(static_cast<std::uint32_t>(j));
+                    result.values_.push_back(row[j]);
+                }
+            }
+            result.rowOffsets_[i + 1] = result.values_.size();
+        }
+        return result;
+    }
+
+    // 从 COO 三元组流构建，三元组可以是任意顺序；同一位置出现多次时把值相加。
+    // 先按行做计数排序 (两遍，O(nnz))，再在每行内部按列排序并合并重复项。
+    template <typename InputIt>
+    static CsrMatrix fromTriplets(std::size_t rows, std::size_t cols, InputIt first, InputIt last)
+    {
+        checkCols(cols);
+        std::vector<Triplet<T>> triplets(first, last);
+
+        CsrMatrix result;
+        result.rows_ = rows;
+        result.cols_ = cols;
+        result.rowOffsets_.assign(rows + 1, 0);
+        for (const Triplet<T>& t : triplets)
+        {
+            if (t.row >= rows || t.col >= cols)
+            {
+                throw std::out_of_range("Triplet index out of bounds");
+            }
+            ++result.rowOffsets_[t.row + 1];
+        }
+        for (std::size_t i {0}; i < rows; ++i)
+        {
+            result.rowOffsets_[i + 1] += result.rowOffsets_[i];
+        }
+
+        std::vector<std::size_t> cursor(result.rowOffsets_.begin(), result.rowOffsets_.end() - 1);
+        std::vector<std::uint32_t> cols32(triplets.size());
+        std::vector<T> values(triplets.size());
+        for (const Triplet<T>& t : triplets)
+        {
+            const std::size_t k {cursor[t.row]++};
+            cols32[k] = static_cast<std::uint32_t>(t.col);
+            values[k] = t.value;
+        }
+
+        // 行内按列排序，合并重复列，并压缩掉空隙
+        std::vector<std::pair<std::uint32_t, T>> rowEntries;
+        std::size_t write {0};
+        for (std::size_t i {0}; i < rows; ++i)
+        {
+            const std::size_t begin {result.rowOffsets_[i]};
+            const std::size_t end {result.rowOffsets_[i + 1]};
+            rowEntries.clear();
+            for (std::size_t k {begin}; k < end; ++k)
+            {
+                rowEntries.emplace_back(cols32[k], values[k]);
+            }
+            std::sort(rowEntries.begin(), rowEntries.end(),
+                      [](const auto& a, const auto& b) { return a.first < b.first; });
+
+            result.rowOffsets_[i] = write;
+            for (std::size_t k {0}; k < rowEntries.size(); ++k)
+            {
+                if (write > result.rowOffsets_[i] && cols32[write - 1] == rowEntries[k].first)
+                {
+                    values[write - 1] += rowEntries[k].second;
+                }
+                else
+                {
+                    cols32[write] = rowEntries[k].first;
+                    values[write] = rowEntries[k].second;
+                    ++write;
+                }
+            }
+        }
+        result.rowOffsets_[rows] = write;
+        cols32.resize(write);
+        values.resize(write);
+        result.colIndices_ = std::move(cols32);
+        result.values_ = std::move(values);
+        return result;
+    }
+
+    static CsrMatrix fromTriplets(std::size_t rows, std::size_t cols, const std::vector<Triplet<T>>& triplets)
+    {
+        return fromTriplets(rows, cols, triplets.begin(), triplets.end());
+    }
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    std::size_t nonZeros() const { return values_.size(); }
+
+    const std::vector<std::size_t>& rowOffsets() const { return rowOffsets_; }
+    const std::vector<std::uint32_t>& colIndices() const { return colIndices_; }
+    const std::vector<T>& values() const { return values_; }
+
+    // 三个数组实际占用的字节数
+    std::size_t memoryBytes() const
+    {
+        return rowOffsets_.size() * sizeof(std::size_t) + colIndices_.size() * sizeof(std::uint32_t)
+               + values_.size() * sizeof(T);
+    }
+
+    Matrix<T> toDense() const
+    {
+        Matrix<T> result(rows_, cols_);
+        for (std::size_t i {0}; i < rows_; ++i)
+        {
+            T* row {result.rowPtr(i)};
+            for (std::size_t k {rowOffsets_[i]}; k < rowOffsets_[i + 1]; ++k)
+            {
+                row[colIndices_[k]] = values_[k];
+            }
+        }
+        return result;
+    }
+
+    // 把行切成 parts 段，使每段的非零元素个数大致相同 (而不是行数相同)：
+    // 稀疏矩阵各行的非零个数可能差别很大，按行数平分会让某些线程的工作量远超其它线程
+    std::vector<std::size_t> balancedRowSplits(std::size_t parts) const
+    {
+        parts = std::max<std::size_t>(std::min(parts, std::max<std::size_t>(rows_, 1)), 1);
+        std::vector<std::size_t> splits(parts + 1, rows_);
+        splits[0] = 0;
+        const std::size_t nnz {nonZeros()};
+        for (std::size_t p {1}; p < parts; ++p)
+        {
+            const std::size_t target {nnz * p / parts};
+            auto it {std::lower_bound(rowOffsets_.begin(), rowOffsets_.end(), target)};
+            splits[p] = std::max(splits[p - 1], static_cast<std::size_t>(it - rowOffsets_.begin()));
+            splits[p] = std::min(splits[p], rows_);
+        }
+        return splits;
+    }
+};
+
+namespace sparse_detail
+{
+    // y[i] = sum_k values[k] * x[col[k]]，只处理 [rowBegin, rowEnd)
+    template <typename T>
+    void spmvRows(const CsrMatrix<T>& a, const T* x, T* y, std::size_t rowBegin, std::size_t rowEnd)
+    {
+        const std::size_t* offsets {a.rowOffsets().data()};
+        const std::uint32_t* cols {a.colIndices().data()};
+        const T* values {a.values().data()};
+        for (std::size_t i {rowBegin}; i < rowEnd; ++i)
+        {
+            T sum {};
+            for (std::size_t k {offsets[i]}; k < offsets[i + 1]; ++k)
+            {
+                sum += values[k] * x[cols[k]];
+            }
+            y[i] = sum;
+        }
+    }
+
+    // 按非零个数均衡地切分行，每段作为一个并行块
+    template <typename T, typename Body>
+    void forBalancedRows(const CsrMatrix<T>& a, ThreadPool& pool, Body body)
+    {
+        const std::vector<std::size_t> splits {a.balancedRowSplits(pool.threadCount() * 4)};
+        pool.parallelFor(0, splits.size() - 1, 1, [&splits, &body](std::size_t partBegin, std::size_t partEnd) {
+            for (std::size_t p {partBegin}; p < partEnd; ++p)
+            {
+                body(splits[p], splits[p + 1]);
+            }
+        });
+    }
+}
+
+// 稀疏矩阵 x 稠密向量 (SpMV)：y = A * x。
+// 每个线程写入 y 中互不重叠的一段，每个 y[i] 的累加顺序固定，结果与线程数无关。
+template <typename T>
+std::vector<T> spmv(const CsrMatrix<T>& a, const std::vector<T>& x, ThreadPool& pool = defaultThreadPool())
+{
+    if (x.size() != a.cols())
+    {
+        throw std::invalid_argument("Vector size does not match matrix columns");
+    }
+    std::vector<T> y(a.rows());
+    sparse_detail::forBalancedRows(a, pool, [&](std::size_t rowBegin, std::size_t rowEnd) {
+        sparse_detail::spmvRows(a, x.data(), y.data(), rowBegin, rowEnd);
+    });
+    return y;
+}
+
+// 稀疏矩阵 x 稠密矩阵：C = A * B。
+// 对 A 第 i 行的每个非零 a_ik，把 B 的第 k 行乘以 a_ik 加到 C 的第 i 行——
+// 最内层循环对 B 和 C 都是连续访问，可以被自动向量化
+template <typename T>
+Matrix<T> spmm(const CsrMatrix<T>& a, const Matrix<T>& b, ThreadPool& pool = defaultThreadPool())
+{
+    if (a.cols() != b.rows())
+    {
+        throw std::invalid_argument("Matrix dimensions do not match for multiply");
+    }
+    Matrix<T> result(a.rows(), b.cols());
+    const std::size_t cols {b.cols()};
+    sparse_detail::forBalancedRows(a, pool, [&](std::size_t rowBegin, std::size_t rowEnd) {
+        const std::size_t* offsets {a.rowOffsets().data()};
+        const std::uint32_t* colIndices {a.colIndices().data()};
+        const T* values {a.values().data()};
+        for (std::size_t i {rowBegin}; i < rowEnd; ++i)
+        {
+            T* rowC {result.rowPtr(i)};
+            for (std::size_t k {offsets[i]}; k < offsets[i + 1]; ++k)
+            {
+                const T aik {values[k]};
+                const T* rowB {b.rowPtr(colIndices[k])};
+                for (std::size_t j {0}; j < cols; ++j)
+                {
+                    rowC[j] += aik * rowB[j];
+                }
+            }
+        }
+    });
+    return result;
+}
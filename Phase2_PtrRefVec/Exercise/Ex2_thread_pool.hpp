@@ -0,0 +1,183 @@
+#pragma once
+
+#include <algorithm>          // std::max, std::min
+#include <atomic>             // std::atomic
+#include <condition_variable> // std::condition_variable
+#include <cstddef>            // std::size_t
+#include <exception>          // std::exception_ptr
+#include <functional>         // std::function
+#include <memory>             // std::shared_ptr
+#include <mutex>              // std::mutex
+#include <queue>              // std::queue
+#include <thread>             // std::thread
+#include <utility>            // std::move
+#include <vector>             // std::vector
+
+// 固定大小的线程池：线程在构造时创建一次，之后反复复用，
+// 避免每次并行计算都要付出创建 / 销毁线程的代价。
+class ThreadPool
+{
+private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    bool stopping_ {false};
+
+    void workerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock {mutex_};
+                wakeUp_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (stopping_ && tasks_.empty())
+                {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+            task();
+        }
+    }
+
+public:
+    // threadCount 是参与计算的线程总数 (包括调用 parallelFor 的线程本身)，
+    // 所以只需要额外创建 threadCount - 1 个工作线程
+    explicit ThreadPool(std::size_t threadCount = std::thread::hardware_concurrency())
+    {
+        threadCount = std::max<std::size_t>(threadCount, 1);
+        workers_.reserve(threadCount - 1);
+        for (std::size_t i {1}; i < threadCount; ++i)
+        {
+            workers_.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock {mutex_};
+            stopping_ = true;
+        }
+        wakeUp_.notify_all();
+        for (std::thread& worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    // 线程不能被拷贝，所以线程池也不能被拷贝或移动
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t threadCount() const { return workers_.size() + 1; }
+
+    // 把一个任务放进队列，由某个工作线程异步执行
+    void submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock {mutex_};
+            tasks_.push(std::move(task));
+        }
+        wakeUp_.notify_one();
+    }
+
+    // 把 [begin, end) 切成大小为 grain 的块，body(chunkBegin, chunkEnd) 在各线程上并行执行，
+    // 所有块都完成后才返回。块的划分只取决于 begin / end / grain，与线程数无关；
+    // 只要不同的块写入互不重叠的数据，结果就和串行执行完全一致。
+    // 第一个抛出的异常会在调用线程中重新抛出。
+    template <typename Body>
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Body body)
+    {
+        if (begin >= end)
+        {
+            return;
+        }
+        grain = std::max<std::size_t>(grain, 1);
+        const std::size_t chunkCount {(end - begin + grain - 1) / grain};
+        if (chunkCount == 1 || workers_.empty())
+        {
+            body(begin, end);
+            return;
+        }
+
+        // 共享状态放在 shared_ptr 里：启动较晚的辅助任务可能在 parallelFor 返回之后才运行，
+        // 那时它只会发现没有剩余的块并直接退出
+        struct Job
+        {
+            std::function<void(std::size_t, std::size_t)> body;
+            std::size_t begin;
+            std::size_t end;
+            std::size_t grain;
+            std::size_t chunkCount;
+            std::atomic<std::size_t> nextChunk {0};
+            std::atomic<std::size_t> doneChunks {0};
+            std::exception_ptr error;
+            std::mutex mutex;
+            std::condition_variable finished;
+
+            // 动态地领取块：先完成的线程会继续领取，负载自然均衡
+            void run()
+            {
+                std::size_t chunk;
+                while ((chunk = nextChunk.fetch_add(1)) < chunkCount)
+                {
+                    const std::size_t chunkBegin {begin + chunk * grain};
+                    const std::size_t chunkEnd {std::min(chunkBegin + grain, end)};
+                    try
+                    {
+                        body(chunkBegin, chunkEnd);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock {mutex};
+                        if (!error)
+                        {
+                            error = std::current_exception();
+                        }
+                    }
+                    if (doneChunks.fetch_add(1) + 1 == chunkCount)
+                    {
+                        std::lock_guard<std::mutex> lock {mutex};
+                        finished.notify_all();
+                    }
+                }
+            }
+        };
+
+        auto job {std::make_shared<Job>()};
+        job->body = std::move(body);
+        job->begin = begin;
+        job->end = end;
+        job->grain = grain;
+        job->chunkCount = chunkCount;
+
+        const std::size_t helpers {std::min(workers_.size(), chunkCount - 1)};
+        for (std::size_t i {0}; i < helpers; ++i)
+        {
+            submit([job] { job->run(); });
+        }
+
+        // 调用线程也参与计算；等待的是"所有块完成"而不是"所有辅助任务完成"，
+        // 因此即使在工作线程里嵌套调用 parallelFor 也不会死锁
+        job->run();
+        {
+            std::unique_lock<std::mutex> lock {job->mutex};
+            job->finished.wait(lock, [&] { return job->doneChunks.load() == chunkCount; });
+        }
+        if (job->error)
+        {
+            std::rethrow_exception(job->error);
+        }
+    }
+};
+
+// 进程级别的默认线程池，线程数等于硬件线程数
+inline ThreadPool& defaultThreadPool()
+{
+    static ThreadPool pool;
+    return pool;
+}
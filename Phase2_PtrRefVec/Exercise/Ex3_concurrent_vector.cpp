@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Ex2_thread_pool.hpp"
+#include "Ex3_concurrent_vector.hpp"
+#include "Ex3_my_vector.hpp"
+
+template <typename Func>
+double measureMs(Func f)
+{
+    auto start {std::chrono::steady_clock::now()};
+    f();
+    auto end {std::chrono::steady_clock::now()};
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// 用互斥锁保护的普通向量，作为对照
+template <typename Vector>
+class LockedVector
+{
+private:
+    Vector data_;
+    std::mutex mutex_;
+
+public:
+    void push_back(long long value)
+    {
+        std::lock_guard<std::mutex> lock {mutex_};
+        data_.push_back(value);
+    }
+
+    std::size_t size() const { return data_.size(); }
+    const Vector& data() const { return data_; }
+};
+
+// 每个值 0 ~ count-1 都恰好出现一次
+template <typename Container>
+bool containsEachOnce(const Container& values, std::size_t count)
+{
+    std::vector<char> seen(count, 0);
+    for (long long v : values)
+    {
+        if (v < 0 || static_cast<std::size_t>(v) >= count || seen[static_cast<std::size_t>(v)]++)
+        {
+            return false;
+        }
+    }
+    return values.size() == count;
+}
+
+// 用参数 [元素个数] [线程数] 运行
+int main(int argc, char* argv[])
+{
+    const std::size_t count {argc > 1 ? static_cast<std::size_t>(std::atoll(argv[1])) : 20'000'000};
+    const std::size_t threads {argc > 2 ? static_cast<std::size_t>(std::atoll(argv[2])) : std::thread::hardware_concurrency()};
+    ThreadPool pool {threads};
+    constexpr std::size_t kGrain {4096};
+    constexpr std::size_t kBatch {64};
+    std::cout << count << " 个元素, " << pool.threadCount() << " 个线程\n";
+
+    // 1. 互斥锁 + std::vector / MyVector
+    LockedVector<std::vector<long long>> lockedStd;
+    const double lockedStdMs {measureMs([&] {
+        pool.parallelFor(0, count, kGrain, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i {begin}; i < end; ++i)
+            {
+                lockedStd.push_back(static_cast<long long>(i));
+            }
+        });
+    })};
+    std::cout << "mutex + std::vector:         " << lockedStdMs << " ms, "
+              << (containsEachOnce(lockedStd.data(), count) ? "正确" : "错误!") << '\n';
+
+    LockedVector<MyVector<long long>> lockedMy;
+    const double lockedMyMs {measureMs([&] {
+        pool.parallelFor(0, count, kGrain, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i {begin}; i < end; ++i)
+            {
+                lockedMy.push_back(static_cast<long long>(i));
+            }
+        });
+    })};
+    std::cout << "mutex + MyVector:            " << lockedMyMs << " ms, "
+              << (containsEachOnce(lockedMy.data(), count) ? "正确" : "错误!") << '\n';
+
+    // 2. ConcurrentVector：每个元素一次 fetch_add
+    std::vector<long long> collected;
+    collected.reserve(count);
+    {
+        ConcurrentVector<long long> vec;
+        const double ms {measureMs([&] {
+            pool.parallelFor(0, count, kGrain, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i {begin}; i < end; ++i)
+                {
+                    vec.push_back(static_cast<long long>(i));
+                }
+            });
+        })};
+        vec.forEach([&](std::size_t, long long v) { collected.push_back(v); });
+        std::cout << "ConcurrentVector::push_back: " << ms << " ms, " << (containsEachOnce(collected, count) ? "正确" : "错误!")
+                  << '\n';
+    }
+
+    // 3. ConcurrentVector：每 kBatch 个元素一次 fetch_add
+    collected.clear();
+    {
+        ConcurrentVector<long long> vec;
+        const double ms {measureMs([&] {
+            pool.parallelFor(0, count, kGrain, [&](std::size_t begin, std::size_t end) {
+                long long batch[kBatch];
+                for (std::size_t i {begin}; i < end; i += kBatch)
+                {
+                    const std::size_t n {std::min(kBatch, end - i)};
+                    for (std::size_t j {0}; j < n; ++j)
+                    {
+                        batch[j] = static_cast<long long>(i + j);
+                    }
+                    vec.append(batch, batch + n);
+                }
+            });
+        })};
+        vec.forEach([&](std::size_t, long long v) { collected.push_back(v); });
+        std::cout << "ConcurrentVector::append:    " << ms << " ms, " << (containsEachOnce(collected, count) ? "正确" : "错误!")
+                  << '\n';
+    }
+
+    // 4. 边写边读：读线程拿到的元素地址在整个写入过程中都不变
+    {
+        ConcurrentVector<long long> vec;
+        const std::size_t firstIndex {vec.push_back(-1)};
+        const long long* first {&vec[firstIndex]};
+        std::atomic<bool> writing {true};
+        std::size_t observed {0};
+        bool stable {true};
+        std::thread reader {[&] {
+            while (writing.load())
+            {
+                const std::size_t size {vec.size()};
+                if (size > 1)
+                {
+                    // 最后预留的元素可能还没有构造完，tryGet 会返回 nullptr
+                    if (const long long* last {vec.tryGet(size - 1)})
+                    {
+                        stable = stable && *last >= 0 && *last < static_cast<long long>(count / 10);
+                        ++observed;
+                    }
+                }
+                stable = stable && vec.tryGet(firstIndex) == first;
+            }
+        }};
+        pool.parallelFor(0, count / 10, kGrain, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i {begin}; i < end; ++i)
+            {
+                vec.push_back(static_cast<long long>(i));
+            }
+        });
+        writing.store(false);
+        reader.join();
+        std::cout << "边写边读: 读到 " << observed << " 次, 元素完整、第一个元素的地址" << (stable ? "始终不变" : "发生了变化!") << '\n';
+    }
+    return 0;
+}
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <algorithm>   // std::min
+#include <atomic>      // std::atomic
+#include <cstddef>     // std::size_t, std::max_align_t
+#include <cstdlib>     // std::calloc, std::free
+#include <iterator>    // std::distance
+#include <limits>      // std::numeric_limits
+#include <memory>      // std::destroy_at
+#include <new>         // placement new, std::launder, std::bad_alloc
+#include <stdexcept>   // std::out_of_range
+#include <type_traits> // std::is_trivially_destructible
+#include <utility>     // std::forward, std::move
+
+// 多个线程可以同时追加元素的向量 (只能追加，不能删除单个元素)。
+//
+// 用互斥锁保护 MyVector / std::vector 时，每次 push_back 都要抢同一把锁；
+// 并且扩容会搬动所有元素，其它线程手里的引用随时可能失效，读也必须加锁。
+// 这里换一种存储方式：
+// - 分段存储：第 k 段能放 kFirstSegment * 2^k 个元素，段一旦分配就不再移动，
+//   所以元素的地址在整个生命期内都不变，读线程拿到的引用永远有效；
+//   下标 i 所在的段和段内偏移可以用一次"求最高位"算出来，随机访问仍然是 O(1)
+// - 预留下标：size_.fetch_add(1) 直接得到一个独占的下标，不需要锁也不需要重试 (wait-free)
+// - 发布：每个位置带一个 published 标志，元素构造完后用 release 写入；
+//   读线程用 acquire 读到 true 之后，一定能看到完整构造好的元素。
+//   一段的内存布局是 [n 个标志][n 个元素]，用 calloc 分配：大块内存直接来自 mmap 的零页，
+//   标志天然就是 false，不需要先逐个初始化一遍 (那会把整段内存多写一次)
+// - 分配新段：用 compare_exchange 把新段放进段表，抢输的线程释放自己分配的段 (lock-free)。
+//   为了让这种竞争很少发生，某一段用掉一半时就提前分配下一段
+//
+// 线程安全：push_back / emplace_back / append / reserve / tryGet / at / forEach / size 可以并发调用；
+// operator[] 只能访问已经发布的元素 (例如所有写线程 join 之后)；析构不能与其它操作并发。
+// 元素的构造函数抛异常时，预留的下标永远不会发布，读线程会跳过它。
+template <typename T>
+class ConcurrentVector
+{
+private:
+    static constexpr std::size_t kFirstSegmentBits {5};
+    static constexpr std::size_t kFirstSegment {std::size_t {1} << kFirstSegmentBits};
+    // 所有段加起来覆盖整个 size_t 的范围
+    static constexpr std::size_t kSegmentCount {std::numeric_limits<std::size_t>::digits - kFirstSegmentBits};
+
+    static_assert(alignof(T) <= alignof(std::max_align_t), "ConcurrentVector does not support over-aligned types");
+    static_assert(sizeof(std::atomic<bool>) == 1 && std::atomic<bool>::is_always_lock_free,
+                  "published flags rely on a one-byte lock-free atomic<bool>");
+
+    // 一段内存：前面是标志，后面 (按 T 对齐) 是元素
+    using Segment = unsigned char;
+
+    std::atomic<std::size_t> size_ {0};
+    std::atomic<Segment*> segments_[kSegmentCount] {};
+
+    static std::size_t itemsOffset(std::size_t k) noexcept
+    {
+        return (segmentSize(k) + alignof(T) - 1) / alignof(T) * alignof(T);
+    }
+
+    static std::atomic<bool>& flag(Segment* seg, std::size_t j) noexcept
+    {
+        return reinterpret_cast<std::atomic<bool>*>(seg)[j];
+    }
+
+    static unsigned char* storage(Segment* seg, std::size_t k, std::size_t j) noexcept
+    {
+        return seg + itemsOffset(k) + j * sizeof(T);
+    }
+
+    static T* item(Segment* seg, std::size_t k, std::size_t j) noexcept
+    {
+        return std::launder(reinterpret_cast<T*>(storage(seg, k, j)));
+    }
+
+    // 下标 i 在第 k 段：第 k 段的第一个下标是 kFirstSegment * (2^k - 1)，
+    // 所以 i + kFirstSegment 的最高位正好是 k + kFirstSegmentBits
+    static std::size_t segmentOf(std::size_t i) noexcept
+    {
+        const std::size_t highestBit {static_cast<std::size_t>(std::numeric_limits<unsigned long long>::digits - 1
+                                                               - __builtin_clzll(i + kFirstSegment))};
+        return highestBit - kFirstSegmentBits;
+    }
+
+    static std::size_t segmentSize(std::size_t k) noexcept { return kFirstSegment << k; }
+    static std::size_t segmentStart(std::size_t k) noexcept { return (kFirstSegment << k) - kFirstSegment; }
+
+    // 取第 k 段，还没有分配就分配一个；多个线程同时分配时只有一个能放进段表
+    Segment* segment(std::size_t k)
+    {
+        Segment* current {segments_[k].load(std::memory_order_acquire)};
+        if (current != nullptr)
+        {
+            return current;
+        }
+        auto* fresh {static_cast<Segment*>(std::calloc(itemsOffset(k) + segmentSize(k) * sizeof(T), 1))};
+        if (fresh == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        if (segments_[k].compare_exchange_strong(current, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            return fresh;
+        }
+        std::free(fresh);
+        return current;
+    }
+
+    // 预留的 [first, first + count) 中如果包含某段的中点，就提前分配下一段
+    void prepareNext(std::size_t first, std::size_t count)
+    {
+        const std::size_t last {first + count - 1};
+        for (std::size_t k {segmentOf(first)}; k <= segmentOf(last) && k + 1 < kSegmentCount; ++k)
+        {
+            const std::size_t middle {segmentStart(k) + segmentSize(k) / 2};
+            if (first <= middle && middle <= last)
+            {
+                segment(k + 1);
+            }
+        }
+    }
+
+    template <typename... Args>
+    void construct(std::size_t i, Args&&... args)
+    {
+        const std::size_t k {segmentOf(i)};
+        const std::size_t j {i - segmentStart(k)};
+        Segment* const seg {segment(k)};
+        ::new (static_cast<void*>(storage(seg, k, j))) T(std::forward<Args>(args)...);
+        flag(seg, j).store(true, std::memory_order_release);
+    }
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    ConcurrentVector() = default;
+
+    ~ConcurrentVector()
+    {
+        for (std::size_t k {0}; k < kSegmentCount; ++k)
+        {
+            Segment* const seg {segments_[k].load(std::memory_order_relaxed)};
+            if (seg == nullptr)
+            {
+                continue;
+            }
+            if constexpr (!std::is_trivially_destructible<T>::value)
+            {
+                for (std::size_t j {0}; j < segmentSize(k); ++j)
+                {
+                    if (flag(seg, j).load(std::memory_order_relaxed))
+                    {
+                        std::destroy_at(item(seg, k, j));
+                    }
+                }
+            }
+            std::free(seg);
+        }
+    }
+
+    // 其它线程可能正持有元素的引用，所以既不能拷贝也不能移动
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    // 在末尾构造一个元素，返回它的下标
+    template <typename... Args>
+    std::size_t emplace_back(Args&&... args)
+    {
+        const std::size_t i {size_.fetch_add(1, std::memory_order_relaxed)};
+        construct(i, std::forward<Args>(args)...);
+        prepareNext(i, 1);
+        return i;
+    }
+
+    std::size_t push_back(const T& value) { return emplace_back(value); }
+    std::size_t push_back(T&& value) { return emplace_back(std::move(value)); }
+
+    // 一次预留一整段连续的下标再逐个构造，返回第一个下标。
+    // 批量追加时 fetch_add 的次数少得多，不同线程写的位置也不会落在同一条缓存行上
+    template <typename ForwardIt>
+    std::size_t append(ForwardIt first, ForwardIt last)
+    {
+        const std::size_t count {static_cast<std::size_t>(std::distance(first, last))};
+        const std::size_t start {size_.fetch_add(count, std::memory_order_relaxed)};
+        if (count == 0)
+        {
+            return start;
+        }
+        prepareNext(start, count);
+        for (std::size_t i {start}; first != last; ++first, ++i)
+        {
+            construct(i, *first);
+        }
+        return start;
+    }
+
+    // 提前分配能容纳 count 个元素的所有段
+    void reserve(std::size_t count)
+    {
+        if (count > 0)
+        {
+            for (std::size_t k {0}; k <= segmentOf(count - 1); ++k)
+            {
+                segment(k);
+            }
+        }
+    }
+
+    // 已经预留的下标个数，其中可能有还没有构造完成的元素
+    std::size_t size() const noexcept { return size_.load(std::memory_order_acquire); }
+    bool empty() const noexcept { return size() == 0; }
+
+    // 元素 i 已经发布时返回它的地址，否则返回 nullptr
+    const T* tryGet(std::size_t i) const noexcept
+    {
+        if (i >= size_.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        const std::size_t k {segmentOf(i)};
+        const std::size_t j {i - segmentStart(k)};
+        Segment* const seg {segments_[k].load(std::memory_order_acquire)};
+        if (seg == nullptr || !flag(seg, j).load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        return item(seg, k, j);
+    }
+
+    const T& at(std::size_t i) const
+    {
+        const T* const element {tryGet(i)};
+        if (element == nullptr)
+        {
+            throw std::out_of_range("ConcurrentVector element is not published");
+        }
+        return *element;
+    }
+
+    // 不检查是否已经发布
+    T& operator[](std::size_t i)
+    {
+        const std::size_t k {segmentOf(i)};
+        return *item(segments_[k].load(std::memory_order_acquire), k, i - segmentStart(k));
+    }
+
+    const T& operator[](std::size_t i) const
+    {
+        const std::size_t k {segmentOf(i)};
+        return *item(segments_[k].load(std::memory_order_acquire), k, i - segmentStart(k));
+    }
+
+    // 按下标顺序访问调用时已经发布的元素，f(index, element)
+    template <typename Func>
+    void forEach(Func f) const
+    {
+        const std::size_t count {size()};
+        for (std::size_t k {0}; k < kSegmentCount && segmentStart(k) < count; ++k)
+        {
+            Segment* const seg {segments_[k].load(std::memory_order_acquire)};
+            if (seg == nullptr)
+            {
+                continue;
+            }
+            const std::size_t end {std::min(segmentSize(k), count - segmentStart(k))};
+            for (std::size_t j {0}; j < end; ++j)
+            {
+                if (flag(seg, j).load(std::memory_order_acquire))
+                {
+                    f(segmentStart(k) + j, *item(seg, k, j));
+                }
+            }
+        }
+    }
+};
@@ -0,0 +1,623 @@
+#pragma once
+
+#include <algorithm>        // std::max, std::min, std::equal
+#include <cstddef>          // std::size_t
+#include <cstring>          // std::memcpy
+#include <initializer_list> // std::initializer_list
+#include <limits>           // std::numeric_limits
+#include <memory>           // std::allocator, std::uninitialized_*, std::destroy_n
+#include <new>              // placement new
+#include <stdexcept>        // std::out_of_range, std::length_error
+#include <type_traits>      // std::is_nothrow_move_constructible, std::is_copy_constructible
+#include <utility>          // std::move, std::forward, std::swap
+
+#if defined(__linux__)
+#include <sys/mman.h> // mmap, mremap, munmap
+#define MY_VECTOR_HAS_MREMAP 1
+#else
+#define MY_VECTOR_HAS_MREMAP 0
+#endif
+
+// 增长策略：容量不够时新容量 = max(需要的容量, 旧容量 * Num / Den)。
+// 几何增长保证 push_back 的均摊复杂度是 O(1)：n 次插入总共只搬运 O(n) 个元素。
+// - 2 倍 (libstdc++ / libc++ 的做法)：重新分配的次数最少
+// - 1.5 倍 (MSVC、folly::fbvector 的做法)：新缓冲区有机会复用之前释放的内存块，峰值内存更低
+template <std::size_t Num, std::size_t Den>
+struct GeometricGrowth
+{
+    static_assert(Den > 0 && Num > Den, "Growth factor must be greater than 1");
+
+    static std::size_t next(std::size_t capacity, std::size_t required)
+    {
+        const std::size_t grown {capacity > std::numeric_limits<std::size_t>::max() / Num
+                                     ? std::numeric_limits<std::size_t>::max()
+                                     : capacity * Num / Den};
+        // 容量很小时 (例如 1 * 3 / 2 == 1) 至少增加一个元素
+        return std::max({required, grown, capacity + 1});
+    }
+};
+
+using DefaultGrowth = GeometricGrowth<2, 1>;
+
+// 可以"平凡搬迁"的类型：把对象的字节 memcpy 到别处，再当作旧对象从未存在 (不调用析构函数)，
+// 结果和 "移动构造到新位置 + 销毁旧对象" 完全一样。
+// 可平凡拷贝的类型 (int、double、POD 结构体) 自动满足；很多不可平凡拷贝的类型其实也满足，
+// 例如 std::unique_ptr，以及只包含这类成员的结构体，它们可以用两种方式声明：
+//   struct Handle { ...; using is_trivially_relocatable = std::true_type; };
+//   template <> struct IsTriviallyRelocatable<Handle> : std::true_type {};
+// 注意对象里有指向自己的指针时不能这样声明 (例如 libstdc++ 的 std::string 把短字符串放在对象内部，
+// _M_p 指向自己的缓冲区，memcpy 之后会指向旧对象)。
+namespace my_vector_detail
+{
+    template <typename T, typename = void>
+    struct HasRelocatableMarker : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct HasRelocatableMarker<T, std::void_t<typename T::is_trivially_relocatable>>
+        : T::is_trivially_relocatable
+    {
+    };
+}
+
+template <typename T>
+struct IsTriviallyRelocatable
+    : std::bool_constant<std::is_trivially_copyable<T>::value || my_vector_detail::HasRelocatableMarker<T>::value>
+{
+};
+
+template <typename T, typename D>
+struct IsTriviallyRelocatable<std::unique_ptr<T, D>> : IsTriviallyRelocatable<D>
+{
+};
+
+namespace my_vector_detail
+{
+    // 大于等于这个字节数的缓冲区 (只对可平凡搬迁的类型) 直接用 mmap 向内核要内存，
+    // 扩容时用 mremap：内核只是把物理页重新映射到更大的虚拟地址区间，不复制任何数据，
+    // 几 GB 的向量扩容也只需要几微秒 (只修改页表)
+    constexpr std::size_t kMmapThreshold {2 * 1024 * 1024};
+
+#if MY_VECTOR_HAS_MREMAP
+    // 统计用的钩子：每次 mmap / mremap / munmap 成功之后调用 mapHook(旧字节数, 新字节数)，
+    // 分配时旧字节数是 0，释放时新字节数是 0 (都已按页取整)。默认为空，不影响正常使用；
+    // 基准测试用它把 MyVector 直接映射的内存计入峰值，不需要替换 libc 的函数
+    inline void (*mapHook)(std::size_t oldBytes, std::size_t newBytes) {nullptr};
+
+    inline std::size_t pageRound(std::size_t bytes)
+    {
+        constexpr std::size_t kPage {4096};
+        return (bytes + kPage - 1) / kPage * kPage;
+    }
+
+    inline void* mapBytes(std::size_t bytes)
+    {
+        void* p {::mmap(nullptr, pageRound(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)};
+        if (p == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+        if (mapHook != nullptr)
+        {
+            mapHook(0, pageRound(bytes));
+        }
+        return p;
+    }
+
+    inline void* remapBytes(void* p, std::size_t oldBytes, std::size_t newBytes)
+    {
+        void* q {::mremap(p, pageRound(oldBytes), pageRound(newBytes), MREMAP_MAYMOVE)};
+        if (q == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+        if (mapHook != nullptr)
+        {
+            mapHook(pageRound(oldBytes), pageRound(newBytes));
+        }
+        return q;
+    }
+
+    inline void unmapBytes(void* p, std::size_t bytes) noexcept
+    {
+        if (::munmap(p, pageRound(bytes)) == 0 && mapHook != nullptr)
+        {
+            mapHook(pageRound(bytes), 0);
+        }
+    }
+#endif
+
+    // 对象内部的原始存储，可以放 N 个还没有构造的 T
+    template <typename T, std::size_t N>
+    struct InlineStorage
+    {
+        alignas(T) unsigned char bytes[N * sizeof(T)];
+
+        T* inlineData() noexcept { return reinterpret_cast<T*>(bytes); }
+    };
+
+    // N == 0 时没有内联存储；MyVector 私有继承它，空基类不占空间
+    template <typename T>
+    struct InlineStorage<T, 0>
+    {
+        T* inlineData() noexcept { return nullptr; }
+    };
+}
+
+// 练习3 的自定义向量：data_ 指向一块能容纳 capacity_ 个元素的原始内存，
+// 其中前 size_ 个元素已经构造，后面的部分还没有构造。
+//
+// 小缓冲区优化：MyVector<T, N> 在对象内部留出 N 个元素的空间，元素不超过 N 个时
+// data_ 指向这块内联存储，完全不分配堆内存，超过 N 个才搬到堆上 (之后按增长策略扩容)。
+// 大部分向量只有十几个元素时，这能省掉绝大多数小块分配，元素也和对象本身在同一条缓存行上。
+// 代价是对象变大 (N * sizeof(T))，并且移动内联的内容只能逐个移动元素，不能直接交换指针：
+// - 移动时 other 在堆上：直接接管它的缓冲区，O(1)
+// - 移动时 other 在内联存储中：把元素逐个移动过来，O(N)
+// N == 0 (默认) 时和普通的 vector 完全一样。
+//
+// 重新分配时，可平凡搬迁的元素 (IsTriviallyRelocatable) 用一次 memcpy 整体搬走，
+// 不再逐个移动构造再逐个析构；缓冲区超过 kMmapThreshold 后改用 mmap / mremap (仅 Linux)，
+// 扩容连 memcpy 都不需要。
+//
+// 异常安全：
+// - 扩容时先在新缓冲区里构造好所有元素，全部成功后才释放旧缓冲区；任何一步抛异常，
+//   原来的内容保持不变 (强异常保证)
+// - 元素的移动构造是 noexcept 时才移动，否则拷贝 (与 std::vector 相同，std::move_if_noexcept)
+template <typename T, std::size_t N = 0, typename Growth = DefaultGrowth>
+class MyVector : private my_vector_detail::InlineStorage<T, N>
+{
+private:
+    using my_vector_detail::InlineStorage<T, N>::inlineData;
+
+    // 移动内联的元素可能抛异常，只有 N == 0 或元素的移动是 noexcept 时整个向量的移动才是 noexcept
+    static constexpr bool kNothrowMove {N == 0 || std::is_nothrow_move_constructible<T>::value};
+    static constexpr bool kRelocatable {IsTriviallyRelocatable<T>::value};
+
+    T* data_;
+    std::size_t size_;
+    std::size_t capacity_;
+
+    // 容量为 capacity 的堆缓冲区是否由 mmap 分配 (由容量就能确定，不需要额外记录)
+    static constexpr bool isMapped(std::size_t capacity) noexcept
+    {
+        return MY_VECTOR_HAS_MREMAP && kRelocatable && capacity > N
+            && capacity >= my_vector_detail::kMmapThreshold / sizeof(T);
+    }
+
+    static T* allocate(std::size_t n)
+    {
+#if MY_VECTOR_HAS_MREMAP
+        if (isMapped(n))
+        {
+            return static_cast<T*>(my_vector_detail::mapBytes(n * sizeof(T)));
+        }
+#endif
+        return n == 0 ? nullptr : std::allocator<T>().allocate(n);
+    }
+
+    // 释放 p 指向的缓冲区；内联存储不需要释放
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        if (p == nullptr || p == inlineData())
+        {
+            return;
+        }
+#if MY_VECTOR_HAS_MREMAP
+        if (isMapped(n))
+        {
+            my_vector_detail::unmapBytes(p, n * sizeof(T));
+            return;
+        }
+#endif
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    // 堆上的缓冲区容量总是大于 N，所以容量等于 N 就说明数据在内联存储中
+    bool isInline() const noexcept
+    {
+        return N > 0 && capacity_ == N;
+    }
+
+    // 把 other 的元素搬进 *this (*this 必须是空的，并且放得下)；other 在堆上时直接接管缓冲区
+    void takeFrom(MyVector& other) noexcept(kNothrowMove)
+    {
+        if (other.isInline())
+        {
+            if constexpr (kRelocatable)
+            {
+                relocate(other.data_, other.size_, data_);
+                size_ = other.size_;
+                other.size_ = 0;
+            }
+            else
+            {
+                std::uninitialized_move_n(other.data_, other.size_, data_);
+                size_ = other.size_;
+                other.clear();
+            }
+            return;
+        }
+        deallocate(data_, capacity_);
+        data_ = other.data_;
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        other.data_ = other.inlineData();
+        other.size_ = 0;
+        other.capacity_ = N;
+    }
+
+    // 把 n 个旧元素搬到未初始化的 dst：能安全移动就移动，否则拷贝。
+    // 标准库的 uninitialized_* 在中途抛异常时会销毁已经构造的元素
+    static void transfer(T* src, std::size_t n, T* dst)
+    {
+        if constexpr (std::is_nothrow_move_constructible<T>::value || !std::is_copy_constructible<T>::value)
+        {
+            std::uninitialized_move_n(src, n, dst);
+        }
+        else
+        {
+            std::uninitialized_copy_n(src, n, dst);
+        }
+    }
+
+    // 把 n 个元素从 src 搬到未初始化的 dst，并结束 src 中元素的生命期。
+    // 可平凡搬迁的类型只需一次 memcpy (不会抛异常)；否则先全部移动 / 拷贝成功，再销毁旧元素
+    static void relocate(T* src, std::size_t n, T* dst)
+    {
+        if constexpr (kRelocatable)
+        {
+            if (n > 0)
+            {
+                std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+            }
+        }
+        else
+        {
+            transfer(src, n, dst);
+            std::destroy_n(src, n);
+        }
+    }
+
+    // 换到容量为 newCapacity 的新缓冲区 (newCapacity >= size_)；
+    // 缩小到 N 以内时搬回内联存储 (只有 shrink_to_fit 会这样做，此时数据一定在堆上)
+    void reallocate(std::size_t newCapacity)
+    {
+        if (newCapacity <= N)
+        {
+            newCapacity = N;
+        }
+#if MY_VECTOR_HAS_MREMAP
+        if (isMapped(capacity_) && isMapped(newCapacity))
+        {
+            data_ = static_cast<T*>(my_vector_detail::remapBytes(data_, capacity_ * sizeof(T), newCapacity * sizeof(T)));
+            capacity_ = newCapacity;
+            return;
+        }
+#endif
+        T* newData {newCapacity == N ? inlineData() : allocate(newCapacity)};
+        try
+        {
+            relocate(data_, size_, newData);
+        }
+        catch (...)
+        {
+            deallocate(newData, newCapacity);
+            throw;
+        }
+        deallocate(data_, capacity_);
+        data_ = newData;
+        capacity_ = newCapacity;
+    }
+
+    std::size_t grownCapacity(std::size_t required) const
+    {
+        if (required > max_size())
+        {
+            throw std::length_error("MyVector is too large");
+        }
+        return std::min(Growth::next(capacity_, required), max_size());
+    }
+
+    // 满了以后的 emplace_back：先在新缓冲区的末尾构造新元素，再搬运旧元素。
+    // 顺序很重要：v.push_back(v[0]) 的参数引用的是旧缓冲区，必须在旧元素被移走之前使用
+    template <typename... Args>
+    T& emplaceGrow(Args&&... args)
+    {
+        const std::size_t newCapacity {grownCapacity(size_ + 1)};
+#if MY_VECTOR_HAS_MREMAP
+        if constexpr (kRelocatable)
+        {
+            if (isMapped(capacity_))
+            {
+                // mremap 会移动旧缓冲区，所以先把新元素构造在一个临时位置，扩容后再 memcpy 进去
+                alignas(T) unsigned char slot[sizeof(T)];
+                T* element {::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...)};
+                try
+                {
+                    reallocate(newCapacity);
+                }
+                catch (...)
+                {
+                    std::destroy_at(element);
+                    throw;
+                }
+                relocate(element, 1, data_ + size_);
+                return data_[size_++];
+            }
+        }
+#endif
+        T* newData {allocate(newCapacity)};
+        try
+        {
+            ::new (static_cast<void*>(newData + size_)) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(newData, newCapacity);
+            throw;
+        }
+        try
+        {
+            relocate(data_, size_, newData);
+        }
+        catch (...)
+        {
+            std::destroy_at(newData + size_);
+            deallocate(newData, newCapacity);
+            throw;
+        }
+        deallocate(data_, capacity_);
+        data_ = newData;
+        capacity_ = newCapacity;
+        return data_[size_++];
+    }
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    // 任务1: 构造函数 —— 空向量不分配内存，一开始使用内联存储 (N == 0 时是空指针)
+    MyVector() noexcept : data_{inlineData()}, size_{0}, capacity_{N} {}
+
+    explicit MyVector(std::size_t count) : MyVector()
+    {
+        resize(count);
+    }
+
+    MyVector(std::size_t count, const T& value) : MyVector()
+    {
+        resize(count, value);
+    }
+
+    MyVector(std::initializer_list<T> values) : MyVector()
+    {
+        reserve(values.size());
+        std::uninitialized_copy(values.begin(), values.end(), data_);
+        size_ = values.size();
+    }
+
+    ~MyVector()
+    {
+        std::destroy_n(data_, size_);
+        deallocate(data_, capacity_);
+    }
+
+    // 拷贝构造：放不进内联存储时只分配恰好 size 个元素的空间。
+    // 委托构造已经完成，拷贝中途抛异常时析构函数会释放缓冲区
+    MyVector(const MyVector& other) : MyVector()
+    {
+        reserve(other.size_);
+        std::uninitialized_copy_n(other.data_, other.size_, data_);
+        size_ = other.size_;
+    }
+
+    // 移动构造：other 在堆上时接管它的缓冲区 O(1)，否则逐个移动内联的元素
+    MyVector(MyVector&& other) noexcept(kNothrowMove) : MyVector()
+    {
+        takeFrom(other);
+    }
+
+    // 拷贝再移动：拷贝失败时 *this 不变
+    MyVector& operator=(const MyVector& other)
+    {
+        if (this != &other)
+        {
+            MyVector copy {other};
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    // 先清空自己再接管 other；other 的元素在内联存储中时，放进 *this 现有的缓冲区 (容量至少是 N)
+    MyVector& operator=(MyVector&& other) noexcept(kNothrowMove)
+    {
+        if (this != &other)
+        {
+            clear();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    // 两边都在堆上时只交换指针，否则借助一个临时对象做三次移动
+    void swap(MyVector& other) noexcept(kNothrowMove)
+    {
+        if (!isInline() && !other.isInline())
+        {
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+            return;
+        }
+        MyVector moved {std::move(other)};
+        other = std::move(*this);
+        *this = std::move(moved);
+    }
+
+    // 任务2、3: size() / capacity()
+    std::size_t size() const noexcept { return size_; }
+    std::size_t capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+    static constexpr std::size_t max_size() noexcept { return std::numeric_limits<std::size_t>::max() / sizeof(T); }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+
+    iterator begin() noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+
+    T& operator[](std::size_t i) { return data_[i]; }
+    const T& operator[](std::size_t i) const { return data_[i]; }
+
+    T& at(std::size_t i)
+    {
+        if (i >= size_)
+        {
+            throw std::out_of_range("MyVector index out of range");
+        }
+        return data_[i];
+    }
+
+    const T& at(std::size_t i) const
+    {
+        if (i >= size_)
+        {
+            throw std::out_of_range("MyVector index out of range");
+        }
+        return data_[i];
+    }
+
+    T& front() { return data_[0]; }
+    const T& front() const { return data_[0]; }
+    T& back() { return data_[size_ - 1]; }
+    const T& back() const { return data_[size_ - 1]; }
+
+    // 在末尾直接构造元素，返回它的引用
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (size_ == capacity_)
+        {
+            return emplaceGrow(std::forward<Args>(args)...);
+        }
+        ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+        return data_[size_++];
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back()
+    {
+        --size_;
+        std::destroy_at(data_ + size_);
+    }
+
+    // 销毁所有元素，但保留容量
+    void clear() noexcept
+    {
+        std::destroy_n(data_, size_);
+        size_ = 0;
+    }
+
+    // 确保至少能容纳 newCapacity 个元素，之后的 push_back 不会再重新分配
+    void reserve(std::size_t newCapacity)
+    {
+        if (newCapacity > capacity_)
+        {
+            if (newCapacity > max_size())
+            {
+                throw std::length_error("MyVector is too large");
+            }
+            reallocate(newCapacity);
+        }
+    }
+
+    // 释放多余的容量 (元素不超过 N 个时搬回内联存储)；重新分配失败时保持原样 (这只是一个请求)
+    void shrink_to_fit()
+    {
+        if (capacity_ > size_ && !isInline())
+        {
+            try
+            {
+                reallocate(size_);
+            }
+            catch (...)
+            {
+            }
+        }
+    }
+
+    // 变大时新元素值初始化 (或拷贝 value)，变小时销毁多余的元素。
+    // 与 push_back 一样按增长策略扩容，逐个加 1 的 resize 也是均摊 O(1)
+    void resize(std::size_t count)
+    {
+        if (count > size_)
+        {
+            if (count > capacity_)
+            {
+                reallocate(grownCapacity(count));
+            }
+            std::uninitialized_value_construct_n(data_ + size_, count - size_);
+        }
+        else
+        {
+            std::destroy_n(data_ + count, size_ - count);
+        }
+        size_ = count;
+    }
+
+    void resize(std::size_t count, const T& value)
+    {
+        if (count > size_)
+        {
+            if (count > capacity_)
+            {
+                // value 可能引用本向量中的元素，先在新缓冲区中构造新增部分 (与 emplaceGrow 同理)
+                MyVector grown;
+                grown.reserve(grownCapacity(count));
+                std::uninitialized_fill_n(grown.data_ + size_, count - size_, value);
+                try
+                {
+                    relocate(data_, size_, grown.data_);
+                }
+                catch (...)
+                {
+                    std::destroy_n(grown.data_ + size_, count - size_);
+                    throw;
+                }
+                size_ = 0; // 旧元素已经搬走 (或已销毁)
+                grown.size_ = count;
+                *this = std::move(grown);
+                return;
+            }
+            std::uninitialized_fill_n(data_ + size_, count - size_, value);
+        }
+        else
+        {
+            std::destroy_n(data_ + count, size_ - count);
+        }
+        size_ = count;
+    }
+
+    friend bool operator==(const MyVector& a, const MyVector& b)
+    {
+        return a.size_ == b.size_ && std::equal(a.begin(), a.end(), b.begin());
+    }
+
+    friend bool operator!=(const MyVector& a, const MyVector& b)
+    {
+        return !(a == b);
+    }
+};
+
+template <typename T, std::size_t N, typename G>
+void swap(MyVector<T, N, G>& a, MyVector<T, N, G>& b) noexcept(noexcept(a.swap(b)))
+{
+    a.swap(b);
+}
@@ -0,0 +1,256 @@
+// 对比 MyVector (2 倍 / 1.5 倍增长) 与 std::vector 的 push_back：
+//   - 吞吐量：ns/次 push_back
+//   - 内存：重新分配的次数、堆内存峰值 (旧缓冲区和新缓冲区同时存在的那一刻)
+// 元素类型分别用 int (可以直接搬运) 和 std::string (移动构造是 noexcept 的非平凡类型)。
+// 然后模拟大量只有几个元素的小向量，对比小缓冲区优化 (MyVector<int, 16>) 省掉的堆分配；
+// 最后对比可平凡搬迁的元素 (一次 memcpy) 与逐个移动的扩容，以及大向量用 mremap 扩容。
+//
+// 用法: ./Ex3_my_vector_benchmark [元素个数]
+// 编译: g++ -std=c++17 -O2 Ex3_my_vector_benchmark.cpp -o Ex3_my_vector_benchmark
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "Ex3_my_vector.hpp"
+
+// ---------------- 统计堆内存：替换全局 operator new / delete ----------------
+// 在每块内存前面放一个 16 字节的头记录大小 (保持 malloc 的对齐)，delete 时才知道释放了多少字节
+namespace heap
+{
+    constexpr std::size_t kHeader {alignof(std::max_align_t)};
+    std::size_t allocations {0};
+    std::size_t current {0};
+    std::size_t peak {0};
+
+    void reset()
+    {
+        allocations = 0;
+        peak = current;
+    }
+
+    void add(std::size_t bytes)
+    {
+        ++allocations;
+        current += bytes;
+        peak = std::max(peak, current);
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    auto* block {static_cast<unsigned char*>(std::malloc(size + heap::kHeader))};
+    if (block == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<std::size_t*>(block) = size;
+    heap::add(size);
+    return block + heap::kHeader;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    if (p != nullptr)
+    {
+        auto* block {static_cast<unsigned char*>(p) - heap::kHeader};
+        heap::current -= *reinterpret_cast<std::size_t*>(block);
+        std::free(block);
+    }
+}
+
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, std::size_t) noexcept { operator delete(p); }
+
+// MyVector 的大缓冲区直接用 mmap / mremap 分配，不经过 operator new：
+// 通过 my_vector_detail::mapHook 计入统计 (只统计 MyVector 自己映射的内存，不影响进程里其他的 mmap)。
+// mremap 算一次分配，但旧的页不会和新的页同时存在
+void countMapping(std::size_t oldBytes, std::size_t newBytes)
+{
+    heap::current -= oldBytes;
+    if (newBytes != 0)
+    {
+        heap::add(newBytes);
+    }
+}
+
+struct Result
+{
+    double nsPerPush;
+    std::size_t allocations;
+    std::size_t peakBytes;
+    std::size_t finalCapacity;
+};
+
+// 逐个 push_back count 个元素 (可以先 reserve)，重复几次取最快的一次
+template <typename Vector, typename Make>
+Result benchmark(std::size_t count, Make make, bool reserveFirst = false)
+{
+    Result result {1e300, 0, 0, 0};
+    for (int repeat {0}; repeat < 5; ++repeat)
+    {
+        const std::size_t before {heap::current};
+        heap::reset();
+        const auto start {std::chrono::steady_clock::now()};
+        {
+            Vector vec;
+            if (reserveFirst)
+            {
+                vec.reserve(count);
+            }
+            for (std::size_t i {0}; i < count; ++i)
+            {
+                vec.push_back(make(i));
+            }
+            result.finalCapacity = vec.capacity();
+        }
+        const auto end {std::chrono::steady_clock::now()};
+        result.nsPerPush = std::min(result.nsPerPush, std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(count));
+        result.allocations = heap::allocations;
+        result.peakBytes = heap::peak - before;
+    }
+    return result;
+}
+
+// 防止求和的循环被优化掉
+volatile long long g_sink {0};
+
+// 模拟请求处理中的临时小向量：每次创建一个向量放入 0 ~ 19 个元素，再求和
+template <typename Vector>
+Result smallVectors(std::size_t count)
+{
+    Result result {1e300, 0, 0, 0};
+    for (int repeat {0}; repeat < 5; ++repeat)
+    {
+        const std::size_t before {heap::current};
+        heap::reset();
+        long long sum {0};
+        const auto start {std::chrono::steady_clock::now()};
+        for (std::size_t i {0}; i < count; ++i)
+        {
+            Vector vec;
+            const int elements {static_cast<int>((i * 7) % 20)};
+            for (int k {0}; k < elements; ++k)
+            {
+                vec.push_back(k);
+            }
+            for (int x : vec)
+            {
+                sum += x;
+            }
+            result.finalCapacity = std::max<std::size_t>(result.finalCapacity, vec.capacity());
+        }
+        const auto end {std::chrono::steady_clock::now()};
+        g_sink = sum;
+        result.nsPerPush = std::min(result.nsPerPush, std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(count));
+        result.allocations = heap::allocations;
+        result.peakBytes = heap::peak - before;
+    }
+    return result;
+}
+
+// 带一个堆上资源的 64 字节对象：移动构造是 noexcept 的，但不可平凡拷贝
+template <bool Relocatable>
+struct Blob
+{
+    std::unique_ptr<int> resource;
+    long long payload[7];
+
+    explicit Blob(std::size_t i) : resource{nullptr}, payload{static_cast<long long>(i)} {}
+
+    // 只有 unique_ptr 和普通数据成员，可以安全地 memcpy；Relocatable == false 时不声明，作为对照
+    using is_trivially_relocatable = std::bool_constant<Relocatable>;
+};
+
+void printRow(const char* name, const Result& r, std::size_t count, std::size_t elementSize)
+{
+    const double payload {static_cast<double>(count * elementSize)};
+    std::cout << std::left << std::setw(30) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << r.nsPerPush << std::setw(10) << r.allocations << std::setw(14) << r.finalCapacity
+              << std::setw(12) << static_cast<double>(r.peakBytes) / (1024.0 * 1024.0) << std::setw(10)
+              << static_cast<double>(r.peakBytes) / payload << '\n';
+}
+
+void printHeader(const std::string& title)
+{
+    std::cout << '\n' << title << '\n'
+              << std::left << std::setw(30) << "container" << std::right << std::setw(10) << "ns/push" << std::setw(10)
+              << "allocs" << std::setw(14) << "capacity" << std::setw(12) << "peak MB" << std::setw(10)
+              << "peak/data" << '\n';
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t count {argc > 1 ? static_cast<std::size_t>(std::atoll(argv[1])) : 10'000'000};
+#if MY_VECTOR_HAS_MREMAP
+    my_vector_detail::mapHook = countMapping;
+#endif
+
+    // 1. int：每次扩容只是搬运一块连续内存
+    {
+        const auto make {[](std::size_t i) { return static_cast<int>(i); }};
+        printHeader("push_back " + std::to_string(count) + " 个 int");
+        printRow("std::vector<int>", benchmark<std::vector<int>>(count, make), count, sizeof(int));
+        printRow("MyVector<int> (2x)", benchmark<MyVector<int>>(count, make), count, sizeof(int));
+        printRow("MyVector<int> (1.5x)", benchmark<MyVector<int, 0, GeometricGrowth<3, 2>>>(count, make), count, sizeof(int));
+    }
+
+    // 2. std::string：扩容时逐个移动构造 (短字符串存放在对象内部，不额外分配)
+    {
+        const std::size_t strings {count / 10};
+        const auto make {[](std::size_t i) { return std::to_string(i); }};
+        printHeader("push_back " + std::to_string(strings) + " 个 std::string");
+        printRow("std::vector<std::string>", benchmark<std::vector<std::string>>(strings, make), strings, sizeof(std::string));
+        printRow("MyVector<std::string> (2x)", benchmark<MyVector<std::string>>(strings, make), strings, sizeof(std::string));
+        printRow("MyVector<std::string> (1.5x)", benchmark<MyVector<std::string, 0, GeometricGrowth<3, 2>>>(strings, make), strings, sizeof(std::string));
+    }
+
+    // 3. 预先 reserve：不再重新分配，峰值就是数据本身
+    {
+        const auto make {[](std::size_t i) { return static_cast<int>(i); }};
+        printHeader("reserve(" + std::to_string(count) + ") 后 push_back");
+        printRow("std::vector<int>", benchmark<std::vector<int>>(count, make, true), count, sizeof(int));
+        printRow("MyVector<int>", benchmark<MyVector<int>>(count, make, true), count, sizeof(int));
+    }
+
+    // 4. 大量小向量：ns/push 一列这里表示每个向量的耗时，capacity 一列是出现过的最大容量
+    {
+        const std::size_t vectors {count / 10};
+        printHeader(std::to_string(vectors) + " 个临时小向量 (0 ~ 19 个元素)");
+        printRow("std::vector<int>", smallVectors<std::vector<int>>(vectors), vectors, sizeof(int));
+        printRow("MyVector<int>", smallVectors<MyVector<int>>(vectors), vectors, sizeof(int));
+        printRow("MyVector<int, 16>", smallVectors<MyVector<int, 16>>(vectors), vectors, sizeof(int));
+    }
+
+    // 5. 非平凡类型的扩容：逐个移动构造 + 析构，还是整块 memcpy / mremap
+    {
+        const std::size_t blobs {count / 5};
+        const auto make {[](std::size_t i) { return Blob<false>{i}; }};
+        const auto makeRelocatable {[](std::size_t i) { return Blob<true>{i}; }};
+        printHeader("push_back " + std::to_string(blobs) + " 个 64 字节的 Blob");
+        printRow("std::vector<Blob>", benchmark<std::vector<Blob<false>>>(blobs, make), blobs, sizeof(Blob<false>));
+        printRow("MyVector<Blob> (move)", benchmark<MyVector<Blob<false>>>(blobs, make), blobs, sizeof(Blob<false>));
+        printRow("MyVector<Blob> (relocate)", benchmark<MyVector<Blob<true>>>(blobs, makeRelocatable), blobs, sizeof(Blob<true>));
+    }
+
+    // 6. 超大的向量：std::vector 每次扩容都要复制全部数据，并且新旧两块内存同时存在
+    {
+        const std::size_t large {count * 20};
+        const auto make {[](std::size_t i) { return static_cast<int>(i); }};
+        printHeader("push_back " + std::to_string(large) + " 个 int (" + std::to_string(large * sizeof(int) >> 20) + " MB)");
+        printRow("std::vector<int>", benchmark<std::vector<int>>(large, make), large, sizeof(int));
+        printRow("MyVector<int> (mremap)", benchmark<MyVector<int>>(large, make), large, sizeof(int));
+    }
+    return 0;
+}
@@ -1,35 +1,150 @@
 #include <iostream>
-#include <cstddef> // For size_t
+#include <memory>
+#include <stdexcept>
+#include <string>
 
-class MyVector {
-private:
-    int* data_;
-    size_t size_;
-    size_t capacity_;
+#include "Ex3_my_vector.hpp" // MyVector 的完整实现
 
-public:
-    // 任务1: 实现构造函数
-    MyVector() {
-        // 在这里初始化你的成员变量
-    }
+// 构造或拷贝时可以被设定为抛异常的类型，用来验证强异常保证
+struct Fragile
+{
+    static inline int copiesUntilThrow {-1};
+    int value;
 
-    // 任务2: 实现 size()
-    size_t size() const {
-        // ...
-    }
+    explicit Fragile(int v) : value{v} {}
 
-    // 任务3: 实现 capacity()
-    size_t capacity() const {
-        // ...
+    Fragile(const Fragile& other) : value{other.value}
+    {
+        if (copiesUntilThrow == 0)
+        {
+            throw std::runtime_error("copy failed");
+        }
+        if (copiesUntilThrow > 0)
+        {
+            --copiesUntilThrow;
+        }
     }
 
-    // ... 其他函数我们稍后实现 ...
+    // 移动构造可能抛异常 (没有 noexcept)，所以 MyVector 扩容时会改用拷贝
+    Fragile(Fragile&& other) : value{other.value} {}
 };
 
+template <typename Vector>
+void print(const char* label, const Vector& vec)
+{
+    std::cout << label << " (size " << vec.size() << ", capacity " << vec.capacity() << "):";
+    for (const auto& x : vec)
+    {
+        std::cout << ' ' << x;
+    }
+    std::cout << '\n';
+}
+
 int main() {
-    // 我们可以先简单测试一下
-    MyVector vec;
+    // 任务1~3: 构造函数、size()、capacity()
+    MyVector<int> vec;
     std::cout << "Initial size: " << vec.size() << std::endl;
     std::cout << "Initial capacity: " << vec.capacity() << std::endl;
+
+    // push_back 时容量按 2 倍增长
+    for (int i {0}; i < 10; ++i)
+    {
+        vec.push_back(i * i);
+        std::cout << "push_back(" << i * i << ") -> size " << vec.size() << ", capacity " << vec.capacity() << '\n';
+    }
+
+    // 1.5 倍增长
+    MyVector<int, 0, GeometricGrowth<3, 2>> slow;
+    std::cout << "\n1.5 倍增长的容量序列:";
+    std::size_t lastCapacity {0};
+    for (int i {0}; i < 100; ++i)
+    {
+        slow.push_back(i);
+        if (slow.capacity() != lastCapacity)
+        {
+            lastCapacity = slow.capacity();
+            std::cout << ' ' << lastCapacity;
+        }
+    }
+    std::cout << '\n';
+
+    // 拷贝、移动、reserve、shrink_to_fit、resize
+    MyVector<std::string> names {"Alice", "Bob"};
+    names.emplace_back(3, 'z');
+    names.push_back(names[0]); // 参数引用自身的元素，扩容时也必须安全
+    MyVector<std::string> copy {names};
+    MyVector<std::string> moved {std::move(names)};
+    print("\ncopy ", copy);
+    print("moved", moved);
+    std::cout << "被移动后的 names: size " << names.size() << ", capacity " << names.capacity() << '\n';
+    moved.reserve(100);
+    print("reserve(100)", moved);
+    moved.shrink_to_fit();
+    print("shrink_to_fit", moved);
+    moved.resize(6, "pad");
+    print("resize(6, \"pad\")", moved);
+    moved.resize(2);
+    print("resize(2)", moved);
+    try
+    {
+        moved.at(5);
+    }
+    catch (const std::out_of_range& e)
+    {
+        std::cout << "at(5): " << e.what() << '\n';
+    }
+
+    // 小缓冲区优化：前 4 个元素放在对象内部，第 5 个元素才分配堆内存
+    std::cout << "\nsizeof(MyVector<int>) = " << sizeof(MyVector<int>) << ", sizeof(MyVector<int, 4>) = "
+              << sizeof(MyVector<int, 4>) << '\n';
+    MyVector<std::string, 4> small {"a", "b", "c"};
+    print("small", small);
+    MyVector<std::string, 4> stolen {std::move(small)}; // 内联的元素逐个移动
+    small.push_back("again");
+    print("move 后的 small", small);
+    print("stolen", stolen);
+    stolen.push_back("d");
+    stolen.push_back("e"); // 超过 4 个，搬到堆上
+    print("stolen 溢出到堆上", stolen);
+    swap(small, stolen); // 一个在内联存储中，一个在堆上
+    print("swap 后 small", small);
+    print("swap 后 stolen", stolen);
+    small.resize(2);
+    small.shrink_to_fit(); // 搬回内联存储
+    print("shrink_to_fit 后 small", small);
+
+    // 可平凡搬迁的类型扩容时整块 memcpy，其余类型逐个移动构造再析构
+    std::cout << std::boolalpha << "\n可平凡搬迁: int " << IsTriviallyRelocatable<int>::value
+              << ", std::unique_ptr<int> " << IsTriviallyRelocatable<std::unique_ptr<int>>::value
+              << ", std::string " << IsTriviallyRelocatable<std::string>::value << '\n';
+    MyVector<std::unique_ptr<int>> owners;
+    for (int i {0}; i < 5; ++i)
+    {
+        owners.push_back(std::make_unique<int>(i * 10));
+    }
+    std::cout << "owners (size " << owners.size() << ", capacity " << owners.capacity() << "): " << *owners.front()
+              << " ... " << *owners.back() << '\n';
+
+    // 强异常保证：扩容时第 3 次拷贝失败，原来的内容保持不变
+    MyVector<Fragile> fragile;
+    for (int i {0}; i < 4; ++i)
+    {
+        fragile.emplace_back(i);
+    }
+    Fragile::copiesUntilThrow = 2;
+    try
+    {
+        fragile.emplace_back(4);
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cout << "\n扩容时抛出异常: " << e.what() << ", size " << fragile.size() << ", capacity "
+                  << fragile.capacity() << ", 内容:";
+        for (const Fragile& f : fragile)
+        {
+            std::cout << ' ' << f.value;
+        }
+        std::cout << '\n';
+    }
     return 0;
 }
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector> // std::vector
+
+// 任务： 创建一个函数，它接收一个整数序列，并返回一个只包含其中偶数的新序列。
+// 两种写法放在头文件里，示例 (vector_string_examples.cpp) 和基准测试 (vector_string_benchmark.cpp) 都用它们。
+
+// --- 旧方法：原始指针（危险且复杂） ---
+inline int* filterEvens_C_Style(const int* inputArray, int inputSize, int& outputSize) {
+    // 1. 第一次遍历以计算偶数的数量，以便知道需要分配多少内存
+    outputSize = 0;
+    for (int i = 0; i < inputSize; ++i) {
+        if (inputArray[i] % 2 == 0) {
+            outputSize++;
+        }
+    }
+
+    // 2. 在堆上分配内存。调用者现在负责删除它！
+    if (outputSize == 0) return nullptr;
+    int* resultArray = new int[outputSize];
+
+    // 3. 第二次遍历以复制偶数
+    int currentIndex = 0;
+    for (int i = 0; i < inputSize; ++i) {
+        if (inputArray[i] % 2 == 0) {
+            resultArray[currentIndex++] = inputArray[i];
+        }
+    }
+    return resultArray;
+}
+
+// --- 现代 C++ 方法：std::vector（安全、简单且高效） ---
+inline std::vector<int> filterEvens_Modern(const std::vector<int>& inputArray) {
+    std::vector<int> resultArray;
+    // 甚至可以预先分配内存以避免重新分配，尽管通常不是必需的。
+    // resultArray.reserve(inputArray.size()); // 性能优化
+
+    for (int number : inputArray) {
+        if (number % 2 == 0) {
+            // vector 会自行管理内存。
+            // 如果其内部缓冲区已满，它会自动分配一个更大的缓冲区。
+            resultArray.push_back(number);
+        }
+    }
+    return resultArray; // C++11 及更高版本可以使用移动语义高效地返回此结果
+}
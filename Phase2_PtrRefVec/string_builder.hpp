@@ -0,0 +1,273 @@
+#pragma once
+
+#include <algorithm>   // std::max, std::copy_n
+#include <charconv>    // std::to_chars
+#include <cstddef>     // std::size_t
+#include <cstring>     // std::memcpy, std::strlen
+#include <functional>  // std::less
+#include <memory>      // std::unique_ptr
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <type_traits> // std::enable_if_t, std::is_integral, std::is_floating_point, std::is_same
+#include <utility>     // std::move
+#include <vector>      // std::vector
+
+// 拼接字符串时只分配一次内存。
+//
+//     std::string message = greeting + ", " + name + "!";
+//
+// 每个 + 都会生成一个临时字符串 (右边追加时还可能扩容好几次)。
+// concat 先把每个参数变成一段 (指针, 长度)：字符串 / string_view / 字符串字面量直接引用原来的字符，
+// 数字用 std::to_chars 格式化到参数自己的小缓冲区里 (不经过 locale 和 ostream)；
+// 然后把所有长度加起来，reserve 一次，再依次复制。
+//
+// 循环里生成大量短消息 (日志、报文) 时，连"每条消息一次分配"也可以省掉：
+// StringBuilder 把消息依次写进自己的一组内存块 (arena)，finish() 返回指向块内的 string_view，
+// reset() 一次性作废所有消息，块留着给下一批用。预热之后整个循环不再有任何堆分配。
+//
+// 支持的参数：std::string、std::string_view、C 字符串、char、bool ("true" / "false")、
+// 整数和浮点数 (std::to_chars 的最短表示)。
+namespace string_builder_detail
+{
+    // 引用参数原有的字符，参数在整个 concat 调用期间都有效
+    struct TextPiece
+    {
+        const char* data;
+        std::size_t size;
+    };
+
+    // 格式化后的数字，放在自己的缓冲区里 (long double 的最短表示也不超过 30 个字符)
+    struct NumberPiece
+    {
+        char data[48];
+        std::size_t size;
+    };
+
+    inline TextPiece toPiece(std::string_view text)
+    {
+        return {text.data(), text.size()};
+    }
+
+    // 字符串字面量和 C 字符串 (必须有这个重载，否则字面量会优先转换成 bool)
+    inline TextPiece toPiece(const char* text)
+    {
+        return {text, std::strlen(text)};
+    }
+
+    inline TextPiece toPiece(const char& c)
+    {
+        return {&c, 1};
+    }
+
+    // 只接受真正的算术类型，指针不会被隐式转换成 bool
+    template <typename T, typename = std::enable_if_t<std::is_integral<T>::value || std::is_floating_point<T>::value>>
+    NumberPiece toPiece(T value)
+    {
+        NumberPiece piece;
+        if constexpr (std::is_same<T, bool>::value)
+        {
+            piece.size = value ? 4 : 5;
+            std::memcpy(piece.data, value ? "true" : "false", piece.size);
+        }
+        else
+        {
+            piece.size = static_cast<std::size_t>(std::to_chars(piece.data, piece.data + sizeof(piece.data), value).ptr - piece.data);
+        }
+        return piece;
+    }
+
+    template <typename... Pieces>
+    std::size_t totalSize(const Pieces&... pieces)
+    {
+        return (std::size_t {0} + ... + pieces.size);
+    }
+
+    template <typename... Pieces>
+    char* copyPieces(char* out, const Pieces&... pieces)
+    {
+        ((out = std::copy_n(pieces.data, pieces.size, out)), ...);
+        return out;
+    }
+
+    // piece 是否引用了 out 自己的字符 (例如 concatAppend(s, s, "x"))
+    template <typename Piece>
+    bool pointsInto(const Piece& piece, const std::string& out)
+    {
+        const std::less<const char*> less;
+        return !less(piece.data, out.data()) && less(piece.data, out.data() + out.size());
+    }
+
+    template <typename... Pieces>
+    void appendPieces(std::string& out, const Pieces&... pieces)
+    {
+        const std::size_t total {out.size() + totalSize(pieces...)};
+        if (total > out.capacity() && (pointsInto(pieces, out) || ...))
+        {
+            // 扩容会释放旧的缓冲区，而有的参数还引用着它：在新字符串里拼好再换进来
+            std::string result;
+            result.reserve(total);
+            result.append(out);
+            (result.append(pieces.data, pieces.size), ...);
+            out.swap(result);
+            return;
+        }
+        // 不扩容时 out 已有的字符不会移动，引用它们的参数仍然有效
+        out.reserve(total);
+        (out.append(pieces.data, pieces.size), ...);
+    }
+}
+
+// 把所有参数拼成一个新字符串，只分配一次
+template <typename... Args>
+std::string concat(const Args&... args)
+{
+    std::string result;
+    string_builder_detail::appendPieces(result, string_builder_detail::toPiece(args)...);
+    return result;
+}
+
+// 追加到已有的字符串末尾 (相当于 out += a + b + ...)，最多扩容一次。
+// 参数可以是 out 本身或指向 out 的 string_view：它们看到的是追加之前的内容
+template <typename... Args>
+void concatAppend(std::string& out, const Args&... args)
+{
+    string_builder_detail::appendPieces(out, string_builder_detail::toPiece(args)...);
+}
+
+// 在一组内存块里依次构建消息。
+//
+// 正在构建的消息总是位于当前块已用部分的后面；当前块放不下时换到下一块
+// (已有的块足够大就复用，否则分配一个新块)，并把已经写好的部分复制过去。
+// finish() 之后消息就固定在块里，返回的 string_view 一直有效，直到 reset() 或 StringBuilder 被销毁。
+class StringBuilder
+{
+private:
+    struct Block
+    {
+        std::unique_ptr<char[]> data;
+        std::size_t size;
+    };
+
+    static constexpr std::size_t kDefaultBlockSize {64 * 1024};
+
+    std::vector<Block> blocks_;
+    std::size_t blockSize_;
+    std::size_t block_ {0}; // 当前块
+    std::size_t used_ {0};  // 当前块中已经 finish 的字节数
+    std::size_t size_ {0};  // 正在构建的消息的长度
+
+    char* messageBegin() const { return blocks_[block_].data.get() + used_; }
+
+    // 保证当前消息后面还能再写 extra 个字节
+    void ensureRoom(std::size_t extra)
+    {
+        if (!blocks_.empty() && used_ + size_ + extra <= blocks_[block_].size)
+        {
+            return;
+        }
+        const std::size_t needed {size_ + extra};
+        std::size_t next {blocks_.empty() ? 0 : block_ + 1};
+        if (next == blocks_.size() || blocks_[next].size < needed)
+        {
+            // 超长的消息单独分配一块，其余的块都是 blockSize_
+            const std::size_t size {std::max(blockSize_, needed)};
+            blocks_.insert(blocks_.begin() + static_cast<std::ptrdiff_t>(next), Block {std::unique_ptr<char[]>(new char[size]), size});
+        }
+        if (size_ > 0)
+        {
+            std::memcpy(blocks_[next].data.get(), messageBegin(), size_);
+        }
+        block_ = next;
+        used_ = 0;
+    }
+
+    template <typename... Pieces>
+    void appendPieces(const Pieces&... pieces)
+    {
+        ensureRoom(string_builder_detail::totalSize(pieces...));
+        char* const end {string_builder_detail::copyPieces(messageBegin() + size_, pieces...)};
+        size_ = static_cast<std::size_t>(end - messageBegin());
+    }
+
+public:
+    explicit StringBuilder(std::size_t blockSize = kDefaultBlockSize) : blockSize_{std::max<std::size_t>(blockSize, 1)} {}
+
+    // 块里的消息被 string_view 引用着，不能拷贝
+    StringBuilder(const StringBuilder&) = delete;
+    StringBuilder& operator=(const StringBuilder&) = delete;
+    // 移动之后源对象没有任何内存块，位置也必须归零，否则再 append 会访问已经不属于它的块
+    StringBuilder(StringBuilder&& other) noexcept
+        : blocks_{std::move(other.blocks_)}, blockSize_{other.blockSize_}, block_{other.block_}, used_{other.used_},
+          size_{other.size_}
+    {
+        other.blocks_.clear();
+        other.block_ = 0;
+        other.used_ = 0;
+        other.size_ = 0;
+    }
+
+    StringBuilder& operator=(StringBuilder&& other) noexcept
+    {
+        if (this != &other)
+        {
+            blocks_ = std::move(other.blocks_);
+            blockSize_ = other.blockSize_;
+            block_ = other.block_;
+            used_ = other.used_;
+            size_ = other.size_;
+            other.blocks_.clear();
+            other.block_ = 0;
+            other.used_ = 0;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    // 追加到正在构建的消息末尾，参数类型与 concat 相同
+    template <typename... Args>
+    StringBuilder& append(const Args&... args)
+    {
+        appendPieces(string_builder_detail::toPiece(args)...);
+        return *this;
+    }
+
+    // 正在构建的消息 (下一次 append 之后可能失效)
+    std::string_view view() const
+    {
+        return blocks_.empty() ? std::string_view {} : std::string_view {messageBegin(), size_};
+    }
+
+    std::string str() const { return std::string {view()}; }
+    std::size_t size() const { return size_; }
+
+    // 结束当前消息并开始下一条，返回的 string_view 在 reset() 之前一直有效
+    std::string_view finish()
+    {
+        const std::string_view message {view()};
+        used_ += size_;
+        size_ = 0;
+        return message;
+    }
+
+    // 丢弃正在构建的消息
+    void clear() { size_ = 0; }
+
+    // 作废所有消息，保留内存块给下一批使用
+    void reset()
+    {
+        block_ = 0;
+        used_ = 0;
+        size_ = 0;
+    }
+
+    // 所有内存块的总大小
+    std::size_t capacity() const
+    {
+        std::size_t total {0};
+        for (const Block& block : blocks_)
+        {
+            total += block.size;
+        }
+        return total;
+    }
+};
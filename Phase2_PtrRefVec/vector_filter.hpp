@@ -0,0 +1,546 @@
+#pragma once
+
+#include <algorithm>   // std::max, std::min
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::int32_t, std::uint32_t
+#include <cstring>     // std::memcpy
+#include <memory>      // std::allocator, std::allocator_traits
+#include <new>         // placement new
+#include <numeric>     // std::partial_sum
+#include <type_traits> // std::is_integral, std::is_same, std::true_type, std::is_nothrow_default_constructible
+#include <utility>     // std::forward
+#include <vector>      // std::vector
+
+#include "Exercise/Ex2_thread_pool.hpp" // ThreadPool, defaultThreadPool
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define FILTER_SIMD_X86 1
+#else
+#define FILTER_SIMD_X86 0
+#endif
+
+// 单遍、向量化的过滤 (stream compaction)。
+//
+// vector_string_examples.cpp 中的 filterEvens_C_Style 先遍历一遍计数、再遍历一遍复制，
+// filterEvens_Modern 对每个偶数调用一次 push_back (不断检查容量、扩容)，而且每个元素一个分支，
+// 奇偶随机时分支预测一半会失败。这里只遍历一遍，并且完全没有分支：
+// - AVX2：一次读 8 个 int，谓词得到每个通道的掩码，movemask 压成 8 位整数；
+//   用它查一张 256 项的表，得到 "把保留的通道依次移到最前面" 的排列，
+//   _mm256_permutevar8x32_epi32 完成压缩，整块写出，输出指针前进 popcount(掩码) 个元素
+// - AVX-512：一次 16 个 int，_mm512_maskz_compress_epi32 直接按掩码压缩，不需要查表
+// - 标量 (以及尾部不足一块的部分)：无条件写入 out[kept]，再让 kept += pred(x)
+//
+// 每次都整块写出，所以 out 必须至少能放下 n 个元素 (最坏情况全部保留)，
+// 超出返回值的部分内容不确定。输入和输出可以是同一块内存 (写入的位置永远不会超过读取的位置)。
+//
+// 谓词：任何 bool(T) 的函数对象都可以用 (走标量路径)；
+// 下面的 IsEven / IsOdd / Greater / Less / InRange 额外提供了 mask256 / mask512，
+// 对 std::int32_t 的输入会走向量路径。自定义谓词也可以用同样的方式提供这两个函数
+// (并声明 using is_simd_predicate = std::true_type)：
+// mask256 返回的向量中，要保留的通道符号位为 1；mask512 返回要保留的通道的位掩码。
+namespace filter_simd
+{
+    enum class Isa
+    {
+        Scalar,
+        AVX2,
+        AVX512,
+    };
+
+    inline const char* isaName(Isa isa)
+    {
+        switch (isa)
+        {
+        case Isa::AVX512: return "AVX-512";
+        case Isa::AVX2: return "AVX2";
+        default: return "Scalar";
+        }
+    }
+
+    struct IsEven
+    {
+        bool operator()(std::int32_t x) const { return (x & 1) == 0; }
+
+#if FILTER_SIMD_X86
+        using is_simd_predicate = std::true_type;
+
+        __attribute__((target("avx2"))) __m256i mask256(__m256i v) const
+        {
+            return _mm256_cmpeq_epi32(_mm256_and_si256(v, _mm256_set1_epi32(1)), _mm256_setzero_si256());
+        }
+
+        __attribute__((target("avx512f"))) __mmask16 mask512(__m512i v) const
+        {
+            return _mm512_testn_epi32_mask(v, _mm512_set1_epi32(1));
+        }
+#endif
+    };
+
+    struct IsOdd
+    {
+        bool operator()(std::int32_t x) const { return (x & 1) != 0; }
+
+#if FILTER_SIMD_X86
+        using is_simd_predicate = std::true_type;
+
+        __attribute__((target("avx2"))) __m256i mask256(__m256i v) const
+        {
+            return _mm256_slli_epi32(v, 31); // 最低位移到符号位
+        }
+
+        __attribute__((target("avx512f"))) __mmask16 mask512(__m512i v) const
+        {
+            return _mm512_test_epi32_mask(v, _mm512_set1_epi32(1));
+        }
+#endif
+    };
+
+    // x > value
+    struct Greater
+    {
+        std::int32_t value;
+
+        bool operator()(std::int32_t x) const { return x > value; }
+
+#if FILTER_SIMD_X86
+        using is_simd_predicate = std::true_type;
+
+        __attribute__((target("avx2"))) __m256i mask256(__m256i v) const
+        {
+            return _mm256_cmpgt_epi32(v, _mm256_set1_epi32(value));
+        }
+
+        __attribute__((target("avx512f"))) __mmask16 mask512(__m512i v) const
+        {
+            return _mm512_cmpgt_epi32_mask(v, _mm512_set1_epi32(value));
+        }
+#endif
+    };
+
+    // x < value
+    struct Less
+    {
+        std::int32_t value;
+
+        bool operator()(std::int32_t x) const { return x < value; }
+
+#if FILTER_SIMD_X86
+        using is_simd_predicate = std::true_type;
+
+        __attribute__((target("avx2"))) __m256i mask256(__m256i v) const
+        {
+            return _mm256_cmpgt_epi32(_mm256_set1_epi32(value), v);
+        }
+
+        __attribute__((target("avx512f"))) __mmask16 mask512(__m512i v) const
+        {
+            return _mm512_cmplt_epi32_mask(v, _mm512_set1_epi32(value));
+        }
+#endif
+    };
+
+    // low <= x <= high
+    struct InRange
+    {
+        std::int32_t low;
+        std::int32_t high;
+
+        bool operator()(std::int32_t x) const { return low <= x && x <= high; }
+
+#if FILTER_SIMD_X86
+        using is_simd_predicate = std::true_type;
+
+        // AVX2 只有 "大于" 比较：x 在范围外 <=> low > x 或 x > high
+        __attribute__((target("avx2"))) __m256i mask256(__m256i v) const
+        {
+            const __m256i outside {_mm256_or_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(low), v),
+                                                   _mm256_cmpgt_epi32(v, _mm256_set1_epi32(high)))};
+            return _mm256_xor_si256(outside, _mm256_set1_epi32(-1));
+        }
+
+        __attribute__((target("avx512f"))) __mmask16 mask512(__m512i v) const
+        {
+            return _mm512_cmpge_epi32_mask(v, _mm512_set1_epi32(low)) & _mm512_cmple_epi32_mask(v, _mm512_set1_epi32(high));
+        }
+#endif
+    };
+
+    // 各个内核的 capacity 是 out 的实际大小 (至少是保留的元素个数)。
+    // 空间足够时无条件整块写出；不够时 (并行过滤时每块的输出区间恰好等于保留的个数)
+    // 只写入保留的元素，不会越过 capacity
+    namespace scalar
+    {
+        template <typename T, typename Pred>
+        std::size_t compact(const T* in, std::size_t n, T* out, std::size_t capacity, Pred pred)
+        {
+            std::size_t kept {0};
+            std::size_t i {0};
+            for (; i < n && capacity - kept < n - i; ++i)
+            {
+                if (pred(in[i]))
+                {
+                    out[kept++] = in[i];
+                }
+            }
+            for (; i < n; ++i)
+            {
+                const T x {in[i]};
+                out[kept] = x;
+                kept += pred(x) ? 1 : 0;
+            }
+            return kept;
+        }
+
+        template <typename T, typename Pred>
+        std::size_t count(const T* in, std::size_t n, Pred pred)
+        {
+            std::size_t kept {0};
+            for (std::size_t i {0}; i < n; ++i)
+            {
+                kept += pred(in[i]) ? 1 : 0;
+            }
+            return kept;
+        }
+    }
+
+#if FILTER_SIMD_X86
+    // 谓词是否提供了向量版本
+    template <typename Pred, typename = void>
+    struct HasSimdMask : std::false_type
+    {
+    };
+
+    template <typename Pred>
+    struct HasSimdMask<Pred, std::void_t<typename Pred::is_simd_predicate>> : Pred::is_simd_predicate
+    {
+    };
+
+    namespace avx2
+    {
+        // kCompress.lanes[mask] 把 mask 中为 1 的通道号依次排在前面，其余位置填 0
+        struct CompressTable
+        {
+            alignas(32) std::uint32_t lanes[256][8];
+        };
+
+        constexpr CompressTable makeCompressTable()
+        {
+            CompressTable table {};
+            for (unsigned mask {0}; mask < 256; ++mask)
+            {
+                unsigned next {0};
+                for (unsigned lane {0}; lane < 8; ++lane)
+                {
+                    if ((mask >> lane) & 1)
+                    {
+                        table.lanes[mask][next++] = lane;
+                    }
+                }
+            }
+            return table;
+        }
+
+        inline constexpr CompressTable kCompress {makeCompressTable()};
+
+        template <typename Pred>
+        __attribute__((target("avx2,popcnt"))) inline std::size_t compactBlock(const std::int32_t* in, std::int32_t* out,
+                                                                                 const Pred& pred)
+        {
+            const __m256i v {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in))};
+            const unsigned mask {static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(pred.mask256(v))))};
+            const __m256i permutation {_mm256_load_si256(reinterpret_cast<const __m256i*>(kCompress.lanes[mask]))};
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permutevar8x32_epi32(v, permutation));
+            return static_cast<std::size_t>(__builtin_popcount(mask));
+        }
+
+        template <typename Pred>
+        __attribute__((target("avx2,popcnt"))) inline std::size_t compact(const std::int32_t* in, std::size_t n,
+                                                                            std::int32_t* out, std::size_t capacity,
+                                                                            Pred pred)
+        {
+            std::size_t kept {0};
+            std::size_t i {0};
+            // 每次处理两块：两块的读取和比较互不依赖，可以重叠执行
+            for (; i + 16 <= n && kept + 16 <= capacity; i += 16)
+            {
+                kept += compactBlock(in + i, out + kept, pred);
+                kept += compactBlock(in + i + 8, out + kept, pred);
+            }
+            for (; i + 8 <= n && kept + 8 <= capacity; i += 8)
+            {
+                kept += compactBlock(in + i, out + kept, pred);
+            }
+            // 剩余空间放不下一整块：先压缩到栈上，再只复制保留下来的元素
+            alignas(32) std::int32_t spill[8];
+            for (; i + 8 <= n; i += 8)
+            {
+                const std::size_t k {compactBlock(in + i, spill, pred)};
+                std::memcpy(out + kept, spill, k * sizeof(std::int32_t));
+                kept += k;
+            }
+            return kept + scalar::compact(in + i, n - i, out + kept, capacity - kept, pred);
+        }
+
+        template <typename Pred>
+        __attribute__((target("avx2,popcnt"))) inline std::size_t count(const std::int32_t* in, std::size_t n, Pred pred)
+        {
+            std::size_t kept {0};
+            std::size_t i {0};
+            for (; i + 8 <= n; i += 8)
+            {
+                const __m256i v {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i))};
+                kept += static_cast<std::size_t>(
+                    __builtin_popcount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(pred.mask256(v))))));
+            }
+            return kept + scalar::count(in + i, n - i, pred);
+        }
+    }
+
+    namespace avx512
+    {
+        template <typename Pred>
+        __attribute__((target("avx512f,popcnt"))) inline std::size_t compact(const std::int32_t* in, std::size_t n,
+                                                                              std::int32_t* out, std::size_t capacity,
+                                                                              Pred pred)
+        {
+            std::size_t kept {0};
+            std::size_t i {0};
+            for (; i + 32 <= n && kept + 32 <= capacity; i += 32)
+            {
+                const __m512i a {_mm512_loadu_si512(in + i)};
+                const __m512i b {_mm512_loadu_si512(in + i + 16)};
+                const __mmask16 maskA {pred.mask512(a)};
+                const __mmask16 maskB {pred.mask512(b)};
+                // 压缩到寄存器再整块写出；直接 compress 到内存 (compressstoreu) 在部分 CPU 上很慢
+                _mm512_storeu_si512(out + kept, _mm512_maskz_compress_epi32(maskA, a));
+                kept += static_cast<std::size_t>(__builtin_popcount(maskA));
+                _mm512_storeu_si512(out + kept, _mm512_maskz_compress_epi32(maskB, b));
+                kept += static_cast<std::size_t>(__builtin_popcount(maskB));
+            }
+            for (; i + 16 <= n && kept + 16 <= capacity; i += 16)
+            {
+                const __m512i v {_mm512_loadu_si512(in + i)};
+                const __mmask16 mask {pred.mask512(v)};
+                _mm512_storeu_si512(out + kept, _mm512_maskz_compress_epi32(mask, v));
+                kept += static_cast<std::size_t>(__builtin_popcount(mask));
+            }
+            // 剩余空间放不下一整块：只写入保留的通道 (带掩码的写入不会碰到其它位置)
+            for (; i + 16 <= n; i += 16)
+            {
+                const __m512i v {_mm512_loadu_si512(in + i)};
+                const __mmask16 mask {pred.mask512(v)};
+                const std::size_t k {static_cast<std::size_t>(__builtin_popcount(mask))};
+                _mm512_mask_storeu_epi32(out + kept, static_cast<__mmask16>((1u << k) - 1),
+                                         _mm512_maskz_compress_epi32(mask, v));
+                kept += k;
+            }
+            return kept + scalar::compact(in + i, n - i, out + kept, capacity - kept, pred);
+        }
+
+        template <typename Pred>
+        __attribute__((target("avx512f,popcnt"))) inline std::size_t count(const std::int32_t* in, std::size_t n, Pred pred)
+        {
+            std::size_t kept {0};
+            std::size_t i {0};
+            for (; i + 16 <= n; i += 16)
+            {
+                kept += static_cast<std::size_t>(__builtin_popcount(pred.mask512(_mm512_loadu_si512(in + i))));
+            }
+            return kept + scalar::count(in + i, n - i, pred);
+        }
+    }
+#endif
+
+    inline Isa detectIsa()
+    {
+#if FILTER_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return Isa::AVX512;
+        if (__builtin_cpu_supports("avx2")) return Isa::AVX2;
+#endif
+        return Isa::Scalar;
+    }
+
+    inline Isa& activeIsaRef()
+    {
+        static Isa isa {detectIsa()};
+        return isa;
+    }
+
+    // 指定使用的指令集 (用于对比)；请求的指令集不被支持时退回到可用的最高一级
+    inline void useIsa(Isa isa)
+    {
+        static const Isa best {detectIsa()};
+        activeIsaRef() = static_cast<int>(isa) > static_cast<int>(best) ? best : isa;
+    }
+
+    inline Isa activeIsa()
+    {
+        return activeIsaRef();
+    }
+
+    // 按当前指令集选择内核
+    template <typename T, typename Pred>
+    std::size_t compact(const T* in, std::size_t n, T* out, std::size_t capacity, Pred pred)
+    {
+        static_assert(std::is_integral<T>::value, "compactIf works on integer spans");
+#if FILTER_SIMD_X86
+        if constexpr (std::is_same<T, std::int32_t>::value && HasSimdMask<Pred>::value)
+        {
+            switch (activeIsa())
+            {
+            case Isa::AVX512: return avx512::compact(in, n, out, capacity, pred);
+            case Isa::AVX2: return avx2::compact(in, n, out, capacity, pred);
+            default: break;
+            }
+        }
+#endif
+        return scalar::compact(in, n, out, capacity, pred);
+    }
+
+    template <typename T, typename Pred>
+    std::size_t count(const T* in, std::size_t n, Pred pred)
+    {
+#if FILTER_SIMD_X86
+        if constexpr (std::is_same<T, std::int32_t>::value && HasSimdMask<Pred>::value)
+        {
+            switch (activeIsa())
+            {
+            case Isa::AVX512: return avx512::count(in, n, pred);
+            case Isa::AVX2: return avx2::count(in, n, pred);
+            default: break;
+            }
+        }
+#endif
+        return scalar::count(in, n, pred);
+    }
+}
+
+// 把 in[0, n) 中满足 pred 的元素按原顺序写到 out 的开头，返回个数。
+// out 至少要能放下 n 个元素 (见上面的说明)，可以与 in 相同 (就地过滤)
+template <typename T, typename Pred>
+std::size_t compactIf(const T* in, std::size_t n, T* out, Pred pred)
+{
+    return filter_simd::compact(in, n, out, n, pred);
+}
+
+// 满足 pred 的元素个数
+template <typename T, typename Pred>
+std::size_t countIf(const T* in, std::size_t n, Pred pred)
+{
+    return filter_simd::count(in, n, pred);
+}
+
+// 返回新向量的版本：先用 countIf 数出保留的个数 (只读，不写)，输出按这个个数分配，
+// 容量正好等于大小，也不用先把最坏情况的 input.size() 个元素全部写成 0
+template <typename Pred>
+std::vector<int> filterIf(const std::vector<int>& input, Pred pred)
+{
+    std::vector<int> output(countIf(input.data(), input.size(), pred));
+    filter_simd::compact(input.data(), input.size(), output.data(), output.size(), pred);
+    return output;
+}
+
+inline std::vector<int> filterEvens_SIMD(const std::vector<int>& input)
+{
+    return filterIf(input, filter_simd::IsEven {});
+}
+
+// 并行过滤：适合几千万以上的输入，单线程的 compactIf 已经被一个核的带宽限制住了。
+// 1. 把输入切成若干块，各线程并行统计每块保留的个数 (countIf)
+// 2. 对个数求前缀和，得到每块在输出中的起点；总数也就知道了，output 只分配一次
+// 3. 各线程并行把自己的块压缩到各自的区间 [offsets[b], offsets[b + 1])，互不重叠，
+//    所以结果的顺序与输入完全相同，与线程数无关
+// 输入要读两遍 (计数那一遍只读不写)，换来的是输出不需要按最坏情况分配，
+// 也不需要把各线程的局部结果再复制一次合并起来。
+// output 不能是 input；已有的容量会被复用，反复过滤时不会重新分配。
+//
+// std::vector<int> 的 resize 会在调用线程上把新增的元素全部写成 0，
+// 这一遍串行写 (还包括第一次访问时的缺页) 夹在两个并行阶段之间，输入很大时会限制加速比，
+// 而且这些 0 马上又会被覆盖。输出用 filter_simd::DefaultInitVector<int> 时 resize 不写任何东西，
+// 每一页第一次被访问是在各线程压缩自己的块的时候，缺页也分摊到了各个线程。
+namespace filter_simd
+{
+    // construct(p) 默认初始化 (对 int 就是什么都不做)，而不是值初始化成 0；
+    // 其他 construct 和 std::allocator 相同
+    template <typename T, typename Base = std::allocator<T>>
+    struct DefaultInitAllocator : Base
+    {
+        template <typename U>
+        struct rebind
+        {
+            using other = DefaultInitAllocator<U, typename std::allocator_traits<Base>::template rebind_alloc<U>>;
+        };
+
+        using Base::Base;
+
+        template <typename U>
+        void construct(U* p) noexcept(std::is_nothrow_default_constructible<U>::value)
+        {
+            ::new (static_cast<void*>(p)) U;
+        }
+
+        template <typename U, typename... Args>
+        void construct(U* p, Args&&... args)
+        {
+            std::allocator_traits<Base>::construct(static_cast<Base&>(*this), p, std::forward<Args>(args)...);
+        }
+    };
+
+    template <typename T>
+    using DefaultInitVector = std::vector<T, DefaultInitAllocator<T>>;
+
+    // 每块至少 64K 个元素，块数大约是线程数的 4 倍，让先完成的线程可以多领几块
+    constexpr std::size_t kParallelMinBlock {std::size_t {1} << 16};
+
+    inline std::size_t parallelBlockSize(std::size_t n, std::size_t threads)
+    {
+        const std::size_t blocks {std::max<std::size_t>(threads * 4, 1)};
+        return std::max(kParallelMinBlock, (n + blocks - 1) / blocks);
+    }
+}
+
+template <typename Pred, typename Alloc>
+void parallelFilterIf(const std::vector<int>& input, std::vector<int, Alloc>& output, Pred pred,
+                      ThreadPool& pool = defaultThreadPool())
+{
+    const std::size_t n {input.size()};
+    const std::size_t block {filter_simd::parallelBlockSize(n, pool.threadCount())};
+    const std::size_t blocks {(n + block - 1) / block};
+    const int* const in {input.data()};
+
+    // offsets[b + 1] 先存第 b 块的个数，前缀和之后 offsets[b] 就是第 b 块的起点
+    std::vector<std::size_t> offsets(blocks + 1, 0);
+    pool.parallelFor(0, blocks, 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t b {first}; b < last; ++b)
+        {
+            const std::size_t begin {b * block};
+            offsets[b + 1] = countIf(in + begin, std::min(block, n - begin), pred);
+        }
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    output.resize(offsets[blocks]); // DefaultInitVector 不会在这里写入
+    int* const out {output.data()};
+    pool.parallelFor(0, blocks, 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t b {first}; b < last; ++b)
+        {
+            const std::size_t begin {b * block};
+            filter_simd::compact(in + begin, std::min(block, n - begin), out + offsets[b], offsets[b + 1] - offsets[b], pred);
+        }
+    });
+}
+
+template <typename Pred>
+std::vector<int> parallelFilterIf(const std::vector<int>& input, Pred pred, ThreadPool& pool = defaultThreadPool())
+{
+    std::vector<int> output;
+    parallelFilterIf(input, output, pred, pool);
+    return output;
+}
+
+inline std::vector<int> parallelFilterEvens(const std::vector<int>& input, ThreadPool& pool = defaultThreadPool())
+{
+    return parallelFilterIf(input, filter_simd::IsEven {}, pool);
+}
@@ -0,0 +1,393 @@
+#pragma once
+
+#include <cstddef>     // std::size_t
+#include <functional>  // std::plus
+#include <iterator>    // std::begin, std::end
+#include <tuple>       // std::tuple, std::tuple_cat, std::get
+#include <type_traits> // std::decay_t, std::enable_if_t, std::true_type
+#include <utility>     // std::forward, std::move
+
+// 惰性、融合的流水线：
+//
+//     long long total {numbers | pipeline::filter(isEven) | pipeline::transform(square) | pipeline::sum()};
+//
+// filterEvens_Modern 之后再 map 一遍、求和一遍，每一步都要分配并写满一个中间向量，再整个读回来。
+// 这里 filter / transform / take 只是把函数对象记下来，什么都不做；
+// 直到接上一个终结操作 (reduce / sum / collect / collectTo) 才遍历输入，而且只遍历一遍：
+// 每个元素依次穿过所有阶段，直接进入最终结果，中间不产生任何容器。
+//
+// 实现是"推"的方式：终结操作是最内层的 sink，每个阶段把下游的 sink 包一层
+// (FilterSink<Pred, TransformSink<Func, ReduceSink<...>>>)，源头的循环把元素推给最外层。
+// 所有类型在编译期就确定了，没有虚函数也没有 std::function，
+// 内联之后就是一个普通的 for 循环，编译器可以像手写的循环一样把它向量化 (GCC 需要 -O3)。
+// 例外：GCC 12 会把 [](int x) { return x % 2 == 0; } 这样的谓词先化简成"位运算再转成 bool"，
+// 内联进循环之后向量化器不支持这种转换；比较大小的谓词 (x > t 等) 没有这个问题。
+// 只有流水线中含有 take 时，循环才需要在每个元素之后检查是否可以提前结束。
+//
+// 左边是左值容器时，流水线只保存它的引用，所以不要把流水线对象存起来、比容器活得更久；
+// 左边是临时对象时，它会被移动进流水线里。
+namespace pipeline
+{
+    namespace detail
+    {
+        // ---------------- sink：push 一个元素，done 表示不再需要更多元素，result 取出结果 ----------------
+        template <typename Pred, typename Next>
+        struct FilterSink
+        {
+            static constexpr bool kMayStop {Next::kMayStop};
+            Pred pred;
+            Next next;
+
+            template <typename T>
+            void push(T&& x)
+            {
+                if (pred(x))
+                {
+                    next.push(std::forward<T>(x));
+                }
+            }
+
+            bool done() const { return next.done(); }
+            decltype(auto) result() && { return std::move(next).result(); }
+        };
+
+        template <typename Func, typename Next>
+        struct TransformSink
+        {
+            static constexpr bool kMayStop {Next::kMayStop};
+            Func func;
+            Next next;
+
+            template <typename T>
+            void push(T&& x)
+            {
+                next.push(func(std::forward<T>(x)));
+            }
+
+            bool done() const { return next.done(); }
+            decltype(auto) result() && { return std::move(next).result(); }
+        };
+
+        // 源头的循环在每次 push 之前都会检查 done，所以 push 时 remaining 一定大于 0
+        template <typename Next>
+        struct TakeSink
+        {
+            static constexpr bool kMayStop {true};
+            std::size_t remaining;
+            Next next;
+
+            template <typename T>
+            void push(T&& x)
+            {
+                --remaining;
+                next.push(std::forward<T>(x));
+            }
+
+            bool done() const { return remaining == 0 || next.done(); }
+            decltype(auto) result() && { return std::move(next).result(); }
+        };
+
+        template <typename T, typename Op>
+        struct ReduceSink
+        {
+            static constexpr bool kMayStop {false};
+            T accumulator;
+            Op op;
+
+            template <typename U>
+            void push(U&& x)
+            {
+                accumulator = op(std::move(accumulator), std::forward<U>(x));
+            }
+
+            bool done() const { return false; }
+            T result() && { return std::move(accumulator); }
+        };
+
+        template <typename Container>
+        struct CollectSink
+        {
+            static constexpr bool kMayStop {false};
+            Container container;
+
+            template <typename T>
+            void push(T&& x)
+            {
+                container.push_back(std::forward<T>(x));
+            }
+
+            bool done() const { return false; }
+            Container result() && { return std::move(container); }
+        };
+
+        template <typename OutputIt>
+        struct CollectToSink
+        {
+            static constexpr bool kMayStop {false};
+            OutputIt out;
+
+            template <typename T>
+            void push(T&& x)
+            {
+                *out = std::forward<T>(x);
+                ++out;
+            }
+
+            bool done() const { return false; }
+            OutputIt result() && { return out; }
+        };
+    }
+
+    // ---------------- 中间阶段：记下参数，wrap 时把下游的 sink 包起来 ----------------
+    template <typename Pred>
+    struct Filter
+    {
+        using is_pipeline_stage = std::true_type;
+        Pred pred;
+
+        template <typename Next>
+        detail::FilterSink<Pred, Next> wrap(Next next) const
+        {
+            return {pred, std::move(next)};
+        }
+    };
+
+    template <typename Func>
+    struct Transform
+    {
+        using is_pipeline_stage = std::true_type;
+        Func func;
+
+        template <typename Next>
+        detail::TransformSink<Func, Next> wrap(Next next) const
+        {
+            return {func, std::move(next)};
+        }
+    };
+
+    struct Take
+    {
+        using is_pipeline_stage = std::true_type;
+        std::size_t count;
+
+        template <typename Next>
+        detail::TakeSink<Next> wrap(Next next) const
+        {
+            return {count, std::move(next)};
+        }
+    };
+
+    // ---------------- 终结操作：sink() 给出最内层的 sink ----------------
+    template <typename T, typename Op>
+    struct Reduce
+    {
+        using is_pipeline_terminal = std::true_type;
+        T init;
+        Op op;
+
+        detail::ReduceSink<T, Op> sink() const { return {init, op}; }
+    };
+
+    template <typename Container>
+    struct Collect
+    {
+        using is_pipeline_terminal = std::true_type;
+
+        detail::CollectSink<Container> sink() const { return {Container {}}; }
+    };
+
+    template <typename OutputIt>
+    struct CollectTo
+    {
+        using is_pipeline_terminal = std::true_type;
+        OutputIt out;
+
+        detail::CollectToSink<OutputIt> sink() const { return {out}; }
+    };
+
+    template <typename Pred>
+    Filter<std::decay_t<Pred>> filter(Pred&& pred)
+    {
+        return {std::forward<Pred>(pred)};
+    }
+
+    template <typename Func>
+    Transform<std::decay_t<Func>> transform(Func&& func)
+    {
+        return {std::forward<Func>(func)};
+    }
+
+    inline Take take(std::size_t count)
+    {
+        return {count};
+    }
+
+    // op(累计值, 元素) 返回新的累计值
+    template <typename T, typename Op>
+    Reduce<T, std::decay_t<Op>> reduce(T init, Op&& op)
+    {
+        return {std::move(init), std::forward<Op>(op)};
+    }
+
+    // 默认用 long long 累加，避免 int 求和溢出
+    template <typename T = long long>
+    Reduce<T, std::plus<>> sum(T init = T {})
+    {
+        return {init, std::plus<> {}};
+    }
+
+    // 收集到一个新容器 (std::vector、MyVector 等任何有 push_back 的容器)
+    template <typename Container>
+    Collect<Container> collect()
+    {
+        return {};
+    }
+
+    // 依次写到输出迭代器 (例如 std::back_inserter 或预先分配好的数组)，返回写完之后的迭代器
+    template <typename OutputIt>
+    CollectTo<OutputIt> collectTo(OutputIt out)
+    {
+        return {out};
+    }
+
+    // ---------------- 源头 + 若干阶段 ----------------
+    // Range 是左值容器时为 const 引用，是临时对象时为值
+    template <typename Range, typename... Stages>
+    class View
+    {
+    private:
+        Range range_;
+        std::tuple<Stages...> stages_;
+
+        // 从最后一个阶段开始，由内向外把 sink 一层层包起来
+        template <std::size_t I, typename Sink>
+        auto wrap(Sink sink) const
+        {
+            if constexpr (I == 0)
+            {
+                return sink;
+            }
+            else
+            {
+                return wrap<I - 1>(std::get<I - 1>(stages_).wrap(std::move(sink)));
+            }
+        }
+
+    public:
+        View(Range range, std::tuple<Stages...> stages)
+            : range_{std::forward<Range>(range)}, stages_{std::move(stages)}
+        {
+        }
+
+        // 追加一个阶段，得到一个新的流水线 (仍然什么都不做)
+        template <typename Stage>
+        View<Range, Stages..., Stage> then(Stage stage) const&
+        {
+            return {range_, std::tuple_cat(stages_, std::tuple<Stage> {std::move(stage)})};
+        }
+
+        template <typename Stage>
+        View<Range, Stages..., Stage> then(Stage stage) &&
+        {
+            return {std::forward<Range>(range_), std::tuple_cat(std::move(stages_), std::tuple<Stage> {std::move(stage)})};
+        }
+
+        // 唯一的循环：每个元素穿过所有阶段，直接进入终结操作
+        template <typename Terminal>
+        auto run(const Terminal& terminal) const
+        {
+            auto chain {wrap<sizeof...(Stages)>(terminal.sink())};
+            if constexpr (decltype(chain)::kMayStop)
+            {
+                auto it {std::begin(range_)};
+                const auto last {std::end(range_)};
+                for (; it != last && !chain.done(); ++it)
+                {
+                    chain.push(*it);
+                }
+            }
+            else
+            {
+                for (const auto& x : range_)
+                {
+                    chain.push(x);
+                }
+            }
+            return std::move(chain).result();
+        }
+    };
+
+    template <typename T, typename = void>
+    struct IsStage : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct IsStage<T, std::void_t<typename T::is_pipeline_stage>> : std::true_type
+    {
+    };
+
+    template <typename T, typename = void>
+    struct IsTerminal : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct IsTerminal<T, std::void_t<typename T::is_pipeline_terminal>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    struct IsView : std::false_type
+    {
+    };
+
+    template <typename Range, typename... Stages>
+    struct IsView<View<Range, Stages...>> : std::true_type
+    {
+    };
+
+    // 容器 | 阶段
+    template <typename Range, typename Stage,
+              typename = std::enable_if_t<!IsView<std::decay_t<Range>>::value && IsStage<Stage>::value>>
+    View<const Range&, Stage> operator|(const Range& range, Stage stage)
+    {
+        return {range, std::tuple<Stage> {std::move(stage)}};
+    }
+
+    template <typename Range, typename Stage,
+              typename = std::enable_if_t<!std::is_reference<Range>::value && !IsView<Range>::value && IsStage<Stage>::value>>
+    View<Range, Stage> operator|(Range&& range, Stage stage)
+    {
+        return {std::move(range), std::tuple<Stage> {std::move(stage)}};
+    }
+
+    // 流水线 | 阶段
+    template <typename Range, typename... Stages, typename Stage, typename = std::enable_if_t<IsStage<Stage>::value>>
+    View<Range, Stages..., Stage> operator|(const View<Range, Stages...>& view, Stage stage)
+    {
+        return view.then(std::move(stage));
+    }
+
+    template <typename Range, typename... Stages, typename Stage, typename = std::enable_if_t<IsStage<Stage>::value>>
+    View<Range, Stages..., Stage> operator|(View<Range, Stages...>&& view, Stage stage)
+    {
+        return std::move(view).then(std::move(stage));
+    }
+
+    // 流水线 | 终结操作：在这里才真正遍历
+    template <typename Range, typename... Stages, typename Terminal,
+              typename = std::enable_if_t<IsTerminal<Terminal>::value>>
+    auto operator|(const View<Range, Stages...>& view, const Terminal& terminal)
+    {
+        return view.run(terminal);
+    }
+
+    // 容器 | 终结操作 (没有中间阶段)
+    template <typename Range, typename Terminal,
+              typename = std::enable_if_t<!IsView<std::decay_t<Range>>::value && IsTerminal<Terminal>::value>>
+    auto operator|(const Range& range, const Terminal& terminal)
+    {
+        return View<const Range&> {range, std::tuple<> {}}.run(terminal);
+    }
+}
@@ -0,0 +1,453 @@
+#pragma once
+
+#include <algorithm>          // std::max, std::min
+#include <cerrno>             // errno, EINTR
+#include <charconv>           // std::from_chars, std::to_chars
+#include <condition_variable> // std::condition_variable
+#include <cstddef>            // std::size_t
+#include <cstdint>            // std::int8_t, std::int64_t, std::uint32_t, std::uint64_t
+#include <cstring>            // std::memcpy
+#include <exception>          // std::exception_ptr
+#include <memory>             // std::unique_ptr
+#include <mutex>              // std::mutex
+#include <stdexcept>          // std::runtime_error
+#include <string>             // std::string
+#include <system_error>       // std::errc
+#include <thread>             // std::thread
+
+#include <fcntl.h>  // O_RDONLY, O_CREAT ...
+#include <unistd.h> // read
+
+#include "Exercise/Ex1_file_reverse.hpp" // file_reverse_detail::FileHandle, makeBuffer, writeFully, throwErrno
+#include "vector_filter.hpp"             // compactIf, filter_simd::IsEven, FILTER_SIMD_X86
+
+// 流式过滤文件中的整数：输入可以比内存大得多，占用的内存只和块大小有关。
+//
+// - 后台线程按顺序把文件读进两个块大小的缓冲区 (双缓冲)：
+//   主线程解析、过滤当前块的同时，下一块已经在读了，磁盘和 CPU 同时工作
+// - 文本格式：十进制整数，用空白 (空格、制表符、换行) 分隔。
+//   x86 上用 SSSE3 一次解析最多 16 位数字 (没有逐个字符的分支)，块末尾和格式有问题的数字交给 std::from_chars
+//   (两者都不涉及 locale，也不会像 istream >> 那样每个数字都做一次虚调用)；
+//   跨越块边界的数字先暂存起来，和下一块开头的部分拼起来再解析
+// - 二进制格式：连续的 int32 (本机字节序)，文件大小必须是 4 的倍数
+// - 每块解析出的整数用 compactIf (见 vector_filter.hpp) 过滤，保留下来的按同样的格式写到输出文件，
+//   文本格式每行一个数
+//
+// 内存：两个输入缓冲区 + 一个整数数组 + 1 MB 的输出缓冲区，与文件大小无关。
+// 格式错误 (不是整数、超出 int 的范围) 抛 std::runtime_error，读写失败抛 std::system_error。
+enum class IntFileFormat
+{
+    Text,
+    Binary,
+};
+
+struct StreamFilterStats
+{
+    std::uint64_t values {0}; // 读到的整数个数
+    std::uint64_t kept {0};   // 写出的整数个数
+};
+
+namespace stream_filter_detail
+{
+    constexpr std::size_t kChunkSize {4 * 1024 * 1024};
+    constexpr std::size_t kOutputBufferSize {1024 * 1024};
+    // 合法的 int 最多 11 个字符 ("-2147483648")，留些余量给前导零；更长的 token 直接报错
+    constexpr std::size_t kMaxToken {64};
+
+    // 后台线程顺序读文件，两个缓冲区轮流使用：
+    // 主线程持有缓冲区 k 的时候，后台线程在填充缓冲区 k ^ 1
+    class ChunkReader
+    {
+    private:
+        int fd_;
+        std::size_t chunk_;
+        std::unique_ptr<char[]> buffers_[2];
+        std::size_t sizes_[2] {0, 0};
+        bool ready_[2] {false, false};
+        std::size_t current_ {0};
+        bool holding_ {false};
+        bool stopping_ {false};
+        std::exception_ptr error_;
+        std::mutex mutex_;
+        std::condition_variable changed_;
+        std::thread thread_;
+
+        // 读满 bytes 个字节，除非先到了文件末尾
+        std::size_t readUpTo(char* buffer, std::size_t bytes)
+        {
+            std::size_t total {0};
+            while (total < bytes)
+            {
+                const ssize_t n {::read(fd_, buffer + total, bytes - total)};
+                if (n < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (n < 0)
+                {
+                    file_reverse_detail::throwErrno("read");
+                }
+                if (n == 0)
+                {
+                    break;
+                }
+                total += static_cast<std::size_t>(n);
+            }
+            return total;
+        }
+
+        void run()
+        {
+            for (std::size_t k {0};; k ^= 1)
+            {
+                {
+                    std::unique_lock<std::mutex> lock {mutex_};
+                    changed_.wait(lock, [&] { return stopping_ || !ready_[k]; });
+                    if (stopping_)
+                    {
+                        return;
+                    }
+                }
+                std::size_t bytes {0};
+                std::exception_ptr error;
+                try
+                {
+                    bytes = readUpTo(buffers_[k].get(), chunk_);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                {
+                    std::lock_guard<std::mutex> lock {mutex_};
+                    sizes_[k] = bytes;
+                    ready_[k] = true;
+                    error_ = error;
+                }
+                changed_.notify_all();
+                // 读到末尾 (或出错) 的那一块就是最后一块
+                if (bytes < chunk_ || error)
+                {
+                    return;
+                }
+            }
+        }
+
+    public:
+        ChunkReader(int fd, std::size_t chunk)
+            : fd_{fd}, chunk_{chunk}, buffers_{file_reverse_detail::makeBuffer(chunk), file_reverse_detail::makeBuffer(chunk)}
+        {
+            thread_ = std::thread {[this] { run(); }};
+        }
+
+        ~ChunkReader()
+        {
+            {
+                std::lock_guard<std::mutex> lock {mutex_};
+                stopping_ = true;
+            }
+            changed_.notify_all();
+            thread_.join();
+        }
+
+        ChunkReader(const ChunkReader&) = delete;
+        ChunkReader& operator=(const ChunkReader&) = delete;
+
+        // 归还上一块，等待下一块读完。返回的字节数小于块大小时说明这是最后一块 (可能为 0)；
+        // 之后不能再调用 next。data 在下一次调用 next 之前有效，可以就地修改
+        std::size_t next(char*& data)
+        {
+            std::unique_lock<std::mutex> lock {mutex_};
+            if (holding_)
+            {
+                ready_[current_] = false;
+                current_ ^= 1;
+                changed_.notify_all();
+            }
+            changed_.wait(lock, [&] { return ready_[current_]; });
+            holding_ = true;
+            if (error_)
+            {
+                std::rethrow_exception(error_);
+            }
+            data = buffers_[current_].get();
+            return sizes_[current_];
+        }
+    };
+
+    inline bool isSpace(char c)
+    {
+        return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+    }
+
+#if FILTER_SIMD_X86
+    // kDigitShift.lanes[len] 是 _mm_shuffle_epi8 的控制字：把开头的 len 个字节移到 16 字节的最右边，左边补 0
+    struct DigitShiftTable
+    {
+        alignas(16) std::int8_t lanes[17][16];
+    };
+
+    constexpr DigitShiftTable makeDigitShiftTable()
+    {
+        DigitShiftTable table {};
+        for (int len {0}; len <= 16; ++len)
+        {
+            for (int lane {0}; lane < 16; ++lane)
+            {
+                const int source {lane - (16 - len)};
+                table.lanes[len][lane] = static_cast<std::int8_t>(source >= 0 ? source : -128);
+            }
+        }
+        return table;
+    }
+
+    inline constexpr DigitShiftTable kDigitShift {makeDigitShiftTable()};
+
+    // 一次读 16 个字节：比较得到 "不是数字" 的掩码，ctz 就是数字的个数 (没有逐字节的分支)；
+    // 把数字右对齐后，用 maddubs / madd 两两合并：1 位 -> 2 位 -> 4 位 -> 8 位，最后拼成一个 64 位整数。
+    // p 后面必须至少有 16 个可读的字节，返回数字的个数 (16 表示可能还有更多)
+    __attribute__((target("ssse3"))) inline std::size_t parseDigits16(const char* p, std::uint64_t& value)
+    {
+        const __m128i digits {_mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8('0'))};
+        const __m128i isDigit {_mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits)};
+        const unsigned nonDigit {~static_cast<unsigned>(_mm_movemask_epi8(isDigit)) & 0xFFFFu};
+        const std::size_t len {nonDigit != 0 ? static_cast<std::size_t>(__builtin_ctz(nonDigit)) : 16};
+
+        const __m128i aligned {_mm_shuffle_epi8(digits, _mm_load_si128(reinterpret_cast<const __m128i*>(kDigitShift.lanes[len])))};
+        const __m128i pairs {_mm_maddubs_epi16(aligned, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1))};
+        const __m128i quads {_mm_madd_epi16(pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1))};
+        const __m128i octets {_mm_madd_epi16(_mm_packs_epi32(quads, quads), _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1))};
+        const auto high {static_cast<std::uint32_t>(_mm_cvtsi128_si32(octets))};
+        const auto low {static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(octets, 4)))};
+        value = std::uint64_t {high} * 100000000u + low;
+        return len;
+    }
+
+    inline bool hasSsse3()
+    {
+        static const bool supported {__builtin_cpu_supports("ssse3") != 0};
+        return supported;
+    }
+#endif
+
+    // 解析 p 开头、后面紧跟空白的一个 int，成功时返回数字之后的位置。
+    // 其它情况 (格式错误、超出范围、到了块的末尾) 返回 nullptr，由调用者慢慢处理
+    inline const char* parseIntFast(const char* p, const char* end, int& value)
+    {
+#if FILTER_SIMD_X86
+        if (end - p > 16 && hasSsse3())
+        {
+            const bool negative {*p == '-'};
+            const char* const digits {p + (negative ? 1 : 0)};
+            std::uint64_t magnitude {0};
+            const std::size_t len {parseDigits16(digits, magnitude)};
+            const std::uint64_t limit {negative ? std::uint64_t {1} << 31 : (std::uint64_t {1} << 31) - 1};
+            // len <= 10 时 digits[len] 一定在读过的 16 个字节之内，也就在 end 之前
+            if (len == 0 || len > 10 || magnitude > limit || !isSpace(digits[len]))
+            {
+                return nullptr;
+            }
+            value = static_cast<int>(negative ? -static_cast<std::int64_t>(magnitude) : static_cast<std::int64_t>(magnitude));
+            return digits + len;
+        }
+#endif
+        const auto [parsed, error] {std::from_chars(p, end, value)};
+        return error == std::errc {} && parsed != end && isSpace(*parsed) ? parsed : nullptr;
+    }
+
+    inline int parseToken(const char* first, const char* last, std::uint64_t offset)
+    {
+        int value {0};
+        const auto [end, error] {std::from_chars(first, last, value)};
+        if (error != std::errc {} || end != last)
+        {
+            throw std::runtime_error("invalid integer '" + std::string(first, last) + "' at byte " + std::to_string(offset));
+        }
+        return value;
+    }
+
+    // 解析 [data, data + bytes) 中的整数追加到 values，返回个数。
+    // 不是最后一块时，结尾可能是半个数字：把它留在 carry 里，下一块再拼起来解析。
+    // offset 是这一块在文件中的位置，只用于错误信息
+    inline std::size_t parseText(const char* data, std::size_t bytes, bool last, std::string& carry, int* values,
+                                 std::uint64_t offset)
+    {
+        const char* p {data};
+        const char* const end {data + bytes};
+        std::size_t count {0};
+
+        if (!carry.empty())
+        {
+            // carry 紧挨在这一块前面
+            const std::uint64_t carryOffset {offset - carry.size()};
+            const char* tokenEnd {p};
+            while (tokenEnd != end && !isSpace(*tokenEnd))
+            {
+                ++tokenEnd;
+            }
+            carry.append(p, tokenEnd);
+            if (carry.size() > kMaxToken)
+            {
+                throw std::runtime_error("token too long at byte " + std::to_string(carryOffset));
+            }
+            if (tokenEnd == end && !last)
+            {
+                return 0; // 整块都是同一个数字的一部分
+            }
+            values[count++] = parseToken(carry.data(), carry.data() + carry.size(), carryOffset);
+            carry.clear();
+            p = tokenEnd;
+        }
+
+        while (true)
+        {
+            while (p != end && isSpace(*p))
+            {
+                ++p;
+            }
+            if (p == end)
+            {
+                break;
+            }
+            // 通常情况：一次就解析完一个数字，后面紧跟空白
+            int value {0};
+            if (const char* const parsed {parseIntFast(p, end, value)})
+            {
+                values[count++] = value;
+                p = parsed;
+                continue;
+            }
+            // 其余情况：数字可能在块的末尾被截断，或者格式错误
+            const char* tokenEnd {p};
+            while (tokenEnd != end && !isSpace(*tokenEnd))
+            {
+                ++tokenEnd;
+            }
+            const std::uint64_t tokenOffset {offset + static_cast<std::uint64_t>(p - data)};
+            if (tokenEnd == end && !last)
+            {
+                if (static_cast<std::size_t>(end - p) > kMaxToken)
+                {
+                    throw std::runtime_error("token too long at byte " + std::to_string(tokenOffset));
+                }
+                carry.assign(p, end);
+                break;
+            }
+            values[count++] = parseToken(p, tokenEnd, tokenOffset);
+            p = tokenEnd;
+        }
+        return count;
+    }
+
+    // 文本输出：攒满缓冲区再写
+    class TextWriter
+    {
+    private:
+        int fd_;
+        std::unique_ptr<char[]> buffer_ {file_reverse_detail::makeBuffer(kOutputBufferSize)};
+        std::size_t used_ {0};
+        std::uint64_t offset_ {0};
+
+    public:
+        explicit TextWriter(int fd) : fd_{fd} {}
+
+        void write(const int* values, std::size_t count)
+        {
+            // 一个 int 最多 11 个字符，再加一个换行
+            constexpr std::size_t kMaxLine {12};
+            for (std::size_t i {0}; i < count; ++i)
+            {
+                if (kOutputBufferSize - used_ < kMaxLine)
+                {
+                    flush();
+                }
+                char* const begin {buffer_.get() + used_};
+                char* const end {std::to_chars(begin, begin + kMaxLine, values[i]).ptr};
+                *end = '\n';
+                used_ += static_cast<std::size_t>(end - begin) + 1;
+            }
+        }
+
+        void flush()
+        {
+            file_reverse_detail::writeFully(fd_, buffer_.get(), used_, offset_);
+            offset_ += used_;
+            used_ = 0;
+        }
+    };
+}
+
+// 把 input 中满足 pred 的整数按原顺序写到 output (同样的格式)
+template <typename Pred>
+StreamFilterStats filterFile(const std::string& input, const std::string& output, Pred pred,
+                             IntFileFormat format = IntFileFormat::Text,
+                             std::size_t chunk = stream_filter_detail::kChunkSize)
+{
+    using namespace stream_filter_detail;
+    using file_reverse_detail::FileHandle;
+
+    // 二进制格式的块必须由完整的 int 组成
+    chunk = format == IntFileFormat::Binary ? std::max<std::size_t>(chunk / sizeof(int), 1) * sizeof(int)
+                                            : std::max<std::size_t>(chunk, 1);
+    FileHandle in {input, O_RDONLY};
+    FileHandle out {output, O_WRONLY | O_CREAT | O_TRUNC};
+    // 文本中每个数字至少占 2 个字节 (数字 + 分隔符)，再加上从上一块拼过来的那一个
+    const std::unique_ptr<int[]> values {new int[chunk / 2 + 2]};
+    ChunkReader reader {in.get(), chunk};
+    TextWriter text {out.get()};
+    std::string carry;
+    StreamFilterStats stats;
+    std::uint64_t inputOffset {0};
+    std::uint64_t outputOffset {0};
+
+    while (true)
+    {
+        char* data {nullptr};
+        const std::size_t bytes {reader.next(data)};
+        const bool last {bytes < chunk};
+        std::size_t count {0};
+        if (format == IntFileFormat::Text)
+        {
+            count = parseText(data, bytes, last, carry, values.get(), inputOffset);
+        }
+        else
+        {
+            if (bytes % sizeof(int) != 0)
+            {
+                throw std::runtime_error("binary input size is not a multiple of " + std::to_string(sizeof(int)) + ": " + input);
+            }
+            count = bytes / sizeof(int);
+            std::memcpy(values.get(), data, bytes);
+        }
+
+        const std::size_t kept {compactIf(values.get(), count, values.get(), pred)};
+        if (format == IntFileFormat::Text)
+        {
+            text.write(values.get(), kept);
+        }
+        else
+        {
+            file_reverse_detail::writeFully(out.get(), reinterpret_cast<const char*>(values.get()), kept * sizeof(int),
+                                            outputOffset);
+            outputOffset += kept * sizeof(int);
+        }
+        stats.values += count;
+        stats.kept += kept;
+        inputOffset += bytes;
+        if (last)
+        {
+            break;
+        }
+    }
+    if (format == IntFileFormat::Text)
+    {
+        text.flush();
+    }
+    return stats;
+}
+
+inline StreamFilterStats filterEvensFile(const std::string& input, const std::string& output,
+                                         IntFileFormat format = IntFileFormat::Text)
+{
+    return filterFile(input, output, filter_simd::IsEven {}, format);
+}
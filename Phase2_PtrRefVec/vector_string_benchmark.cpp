@@ -0,0 +1,215 @@
+// vector_string_examples.cpp 中各种写法在大数组上的性能对比：
+//   - 过滤：push_back / 两遍的 C 风格 / 向量化的 compactIf (标量、AVX2、AVX-512) / 多线程的 parallelFilterIf
+//   - 过滤 + transform + 求和：中间向量 / 惰性融合流水线 / 手写循环
+//   - 从文件流式过滤 (文本和二进制，临时文件放在系统临时目录，结束后删除)
+//   - 循环中生成日志消息：operator+ / concat / StringBuilder
+// 默认 1 亿个 int，峰值内存超过 1 GB；可以用参数指定更小的规模。
+//
+// 用法: ./vector_string_benchmark [元素个数]
+// 编译: g++ -std=c++17 -O3 -march=native -pthread vector_string_benchmark.cpp -o vector_string_benchmark
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <vector>
+#include <string>
+
+#include "filter_evens.hpp"
+#include "vector_filter.hpp"
+#include "string_builder.hpp"
+#include "vector_pipeline.hpp"
+#include "vector_stream_filter.hpp"
+
+// 计时辅助函数，返回毫秒
+template <typename Func>
+double measureMs(Func f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// 对比几种过滤方式在大数组上的速度 (奇偶随机，分支预测器猜不准)
+void benchmarkFilters(std::size_t n) {
+    std::vector<int> input(n);
+    std::mt19937 rng(42);
+    for (int& x : input) x = static_cast<int>(rng());
+    const double gb = static_cast<double>(n * sizeof(int)) / 1e9;
+    std::cout << n << " 个随机 int (" << gb << " GB):\n";
+
+    const std::vector<int> expected = filterEvens_Modern(input);
+    double ms = measureMs([&] { filterEvens_Modern(input); });
+    std::cout << "  filterEvens_Modern (push_back): " << ms << " ms, " << gb / (ms / 1000) << " GB/s\n";
+
+    int outputSize = 0;
+    ms = measureMs([&] { delete[] filterEvens_C_Style(input.data(), static_cast<int>(n), outputSize); });
+    std::cout << "  filterEvens_C_Style (两遍):     " << ms << " ms, " << gb / (ms / 1000) << " GB/s\n";
+
+    // 输出缓冲区由调用者预先分配 (按最坏情况 n 个)，只遍历一遍
+    std::vector<int> output(n);
+    for (filter_simd::Isa isa : {filter_simd::Isa::Scalar, filter_simd::Isa::AVX2, filter_simd::Isa::AVX512}) {
+        filter_simd::useIsa(isa);
+        std::size_t kept = 0;
+        ms = measureMs([&] { kept = compactIf(input.data(), n, output.data(), filter_simd::IsEven{}); });
+        const bool correct = kept == expected.size() && std::equal(expected.begin(), expected.end(), output.begin());
+        std::cout << "  compactIf (" << std::left << std::setw(8) << filter_simd::isaName(filter_simd::activeIsa())
+                  << std::right << "):      " << ms << " ms, " << gb / (ms / 1000) << " GB/s" << (correct ? "" : " 结果错误!") << "\n";
+    }
+    filter_simd::useIsa(filter_simd::detectIsa());
+
+    // 多线程：分块计数 -> 前缀和 -> 各块并行写入自己的区间。第一次调用要分配输出，
+    // 之后再过滤到同一个向量时复用它的容量。
+    // std::vector<int> 的 resize 在调用线程上先把输出写满 0；DefaultInitVector 不写，由各线程第一次访问
+    const std::size_t threads = defaultThreadPool().threadCount();
+    std::vector<int> zeroedOutput;
+    filter_simd::DefaultInitVector<int> parallelOutput;
+    for (const char* label : {"首次", "复用"}) {
+        ms = measureMs([&] { parallelFilterIf(input, zeroedOutput, filter_simd::IsEven{}); });
+        std::cout << "  parallelFilterIf (" << threads << " 线程, " << label << ", std::vector):       " << ms << " ms, "
+                  << gb / (ms / 1000) << " GB/s" << (zeroedOutput == expected ? "" : " 结果错误!") << "\n";
+        ms = measureMs([&] { parallelFilterIf(input, parallelOutput, filter_simd::IsEven{}); });
+        const bool correct = std::equal(parallelOutput.begin(), parallelOutput.end(), expected.begin(), expected.end());
+        std::cout << "  parallelFilterIf (" << threads << " 线程, " << label << ", DefaultInitVector): " << ms << " ms, "
+                  << gb / (ms / 1000) << " GB/s" << (correct ? "" : " 结果错误!") << "\n";
+    }
+
+    // 参考：同样读 n 个、写 n 个 int 的 memcpy，大致就是内存带宽的上限
+    ms = measureMs([&] { std::memcpy(output.data(), input.data(), n * sizeof(int)); });
+    std::cout << "  memcpy (参考):                  " << ms << " ms, " << gb / (ms / 1000) << " GB/s\n";
+}
+
+// 过滤之后总是还要再 map、再求和：先物化中间向量，还是一个融合的循环。
+// 用 -O3 -march=native 编译时，融合的循环和手写的循环一样会被向量化
+void benchmarkPipeline(const std::vector<int>& input, int threshold) {
+    const auto large = [threshold](int x) { return x > threshold; };
+    const auto square = [](int x) { return static_cast<long long>(x) * x; };
+    std::cout << "大于 " << threshold << " 的元素的平方和:\n";
+
+    // 1. 每一步一个中间向量 (和 filterEvens_Modern 一样用 push_back 收集)
+    long long materialized = 0;
+    double ms = measureMs([&] {
+        std::vector<int> kept;
+        for (int x : input) {
+            if (large(x)) kept.push_back(x);
+        }
+        std::vector<long long> squares(kept.size());
+        std::transform(kept.begin(), kept.end(), squares.begin(), square);
+        materialized = std::accumulate(squares.begin(), squares.end(), 0LL);
+    });
+    std::cout << "  过滤 + transform + accumulate (中间向量): " << ms << " ms\n";
+
+    // 2. 惰性流水线：一个循环，没有中间向量
+    long long fused = 0;
+    ms = measureMs([&] { fused = input | pipeline::filter(large) | pipeline::transform(square) | pipeline::sum(); });
+    std::cout << "  filter | transform | sum (融合):          " << ms << " ms" << (fused == materialized ? "" : " 结果错误!") << "\n";
+
+    // 3. 手写的循环，作为对照
+    long long handWritten = 0;
+    ms = measureMs([&] {
+        for (int x : input) {
+            if (x > threshold) handWritten += static_cast<long long>(x) * x;
+        }
+    });
+    std::cout << "  手写循环:                                 " << ms << " ms" << (handWritten == materialized ? "" : " 结果错误!") << "\n";
+}
+
+// 从文件流式过滤：不管文件多大，占用的内存都只有几个块大小的缓冲区
+void benchmarkStreamFilter(std::size_t n) {
+    // 临时文件放在系统的临时目录里，结束时删除
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const std::string textInput = (directory / "stream_filter_input.txt").string();
+    const std::string textOutput = (directory / "stream_filter_output.txt").string();
+    const std::string binaryInput = (directory / "stream_filter_input.bin").string();
+    const std::string binaryOutput = (directory / "stream_filter_output.bin").string();
+
+    std::vector<int> numbers(n);
+    std::mt19937 rng(11);
+    for (int& x : numbers) x = static_cast<int>(rng()) / 1000;
+    {
+        std::ofstream text(textInput, std::ios::binary | std::ios::trunc);
+        for (int x : numbers) text << x << '\n';
+        std::ofstream binary(binaryInput, std::ios::binary | std::ios::trunc);
+        binary.write(reinterpret_cast<const char*>(numbers.data()), static_cast<std::streamsize>(n * sizeof(int)));
+    }
+
+    // 期望的输出：在内存中过滤，再按同样的格式写出来
+    const std::vector<int> evens = filterEvens_Modern(numbers);
+    std::string expectedText;
+    for (int x : evens) expectedText += std::to_string(x) + '\n';
+    const std::string expectedBinary(reinterpret_cast<const char*>(evens.data()), evens.size() * sizeof(int));
+    const auto readAll = [](const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+
+    std::cout << "从文件流式过滤 " << n << " 个整数 (块大小 " << stream_filter_detail::kChunkSize / (1024 * 1024)
+              << " MB, 双缓冲):\n";
+    StreamFilterStats stats;
+    double ms = measureMs([&] { stats = filterEvensFile(textInput, textOutput, IntFileFormat::Text); });
+    std::cout << "  文本:   " << ms << " ms, 保留 " << stats.kept << " / " << stats.values
+              << (readAll(textOutput) == expectedText ? "" : " 结果错误!") << "\n";
+    ms = measureMs([&] { stats = filterEvensFile(binaryInput, binaryOutput, IntFileFormat::Binary); });
+    std::cout << "  二进制: " << ms << " ms, 保留 " << stats.kept << " / " << stats.values
+              << (readAll(binaryOutput) == expectedBinary ? "" : " 结果错误!") << "\n";
+
+    for (const std::string& path : {textInput, textOutput, binaryInput, binaryOutput}) std::remove(path.c_str());
+}
+
+// 循环中生成大量日志消息：每个 + 一个临时字符串 / 每条消息一次分配 / 预热之后不再分配
+void benchmarkMessages(std::size_t count) {
+    const std::string user = "north_star";
+    std::cout << "生成 " << count << " 条日志消息:\n";
+
+    std::size_t plusBytes = 0;
+    double ms = measureMs([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string line = "request " + std::to_string(i) + " from " + user + " handled in " + std::to_string(i % 997) + " us";
+            plusBytes += line.size();
+        }
+    });
+    std::cout << "  operator+:     " << ms << " ms\n";
+
+    std::size_t concatBytes = 0;
+    ms = measureMs([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string line = concat("request ", i, " from ", user, " handled in ", i % 997, " us");
+            concatBytes += line.size();
+        }
+    });
+    std::cout << "  concat:        " << ms << " ms" << (concatBytes == plusBytes ? "" : " 结果错误!") << "\n";
+
+    // 每 1024 条消息 (例如一批日志写出之后) reset 一次，块一直复用
+    std::size_t builderBytes = 0;
+    StringBuilder builder;
+    ms = measureMs([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            builderBytes += builder.append("request ", i, " from ", user, " handled in ", i % 997, " us").finish().size();
+            if (i % 1024 == 1023) builder.reset();
+        }
+    });
+    std::cout << "  StringBuilder: " << ms << " ms (内存块共 " << builder.capacity() / 1024 << " KB)"
+              << (builderBytes == plusBytes ? "" : " 结果错误!") << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t n = argc > 1 ? static_cast<std::size_t>(std::atoll(argv[1])) : 100'000'000;
+    benchmarkFilters(n);
+    {
+        std::vector<int> input(n);
+        std::mt19937 rng(7);
+        for (int& x : input) x = static_cast<int>(rng() % 100000);
+        benchmarkPipeline(input, 50000);
+    }
+    benchmarkStreamFilter(n / 10);
+    benchmarkMessages(n / 10);
+
+    return 0;
+}
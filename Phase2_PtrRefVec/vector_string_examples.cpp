@@ -1,47 +1,19 @@
 // 任务： 创建一个函数，它接收一个整数序列，并返回一个只包含其中偶数的新序列。
+// 两种写法 (filterEvens_C_Style / filterEvens_Modern) 在 filter_evens.hpp 中；
+// 各种优化版本在大数组上的性能对比见 vector_string_benchmark.cpp。
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <vector>
 #include <string>
 
-// --- 旧方法：原始指针（危险且复杂） ---
-int* filterEvens_C_Style(const int* inputArray, int inputSize, int& outputSize) {
-    // 1. 第一次遍历以计算偶数的数量，以便知道需要分配多少内存
-    outputSize = 0;
-    for (int i = 0; i < inputSize; ++i) {
-        if (inputArray[i] % 2 == 0) {
-            outputSize++;
-        }
-    }
-
-    // 2. 在堆上分配内存。调用者现在负责删除它！
-    if (outputSize == 0) return nullptr;
-    int* resultArray = new int[outputSize];
-
-    // 3. 第二次遍历以复制偶数
-    int currentIndex = 0;
-    for (int i = 0; i < inputSize; ++i) {
-        if (inputArray[i] % 2 == 0) {
-            resultArray[currentIndex++] = inputArray[i];
-        }
-    }
-    return resultArray;
-}
-
-// --- 现代 C++ 方法：std::vector（安全、简单且高效） ---
-std::vector<int> filterEvens_Modern(const std::vector<int>& inputArray) {
-    std::vector<int> resultArray;
-    // 甚至可以预先分配内存以避免重新分配，尽管通常不是必需的。
-    // resultArray.reserve(inputArray.size()); // 性能优化
-
-    for (int number : inputArray) {
-        if (number % 2 == 0) {
-            // vector 会自行管理内存。
-            // 如果其内部缓冲区已满，它会自动分配一个更大的缓冲区。
-            resultArray.push_back(number);
-        }
-    }
-    return resultArray; // C++11 及更高版本可以使用移动语义高效地返回此结果
-}
+#include "Exercise/Ex3_my_vector.hpp"
+#include "filter_evens.hpp"
+#include "vector_filter.hpp"
+#include "string_builder.hpp"
+#include "vector_pipeline.hpp"
+#include "vector_stream_filter.hpp"
 
 void printVec(const std::vector<int>& vec) {
     for (int x : vec) {
@@ -76,5 +48,58 @@ int main() {
     message += " Welcome!";
     std::cout << "\n" << message << " (Length: " << message.length() << ")\n";
 
+    // 同样的消息：先算出总长度，只分配一次 (见 string_builder.hpp)
+    std::string single = concat(greeting, ", ", name, '!', " Welcome!");
+    std::cout << single << " (Length: " << single.length() << ", " << (single == message ? "与上面相同" : "与上面不同!") << ")\n";
+    concatAppend(single, " 第 ", 2, " 次访问, 评分 ", 4.5);
+    std::cout << single << "\n";
+    // 参数引用 out 自己的字符，而且追加时必须扩容
+    std::string repeated(20, 'a');
+    repeated.shrink_to_fit();
+    concatAppend(repeated, repeated, "x", std::string_view(repeated).substr(0, 3));
+    std::cout << "concatAppend(s, s, ...): " << (repeated == std::string(40, 'a') + "xaaa" ? "正确" : "结果错误!") << "\n";
+
+    // === 单遍、向量化的过滤 (见 vector_filter.hpp) ===
+    std::cout << "\n--- 向量化过滤演示 ---\n";
+    printVec(filterEvens_SIMD(vec));
+    printVec(filterIf(vec, filter_simd::InRange{3, 7}));
+    printVec(filterIf(vec, [](int x) { return x % 3 == 0; })); // 普通的 lambda 走标量路径
+    printVec(parallelFilterEvens(vec)); // 多线程版本，结果顺序与输入相同
+
+    // === 惰性流水线 (见 vector_pipeline.hpp)：接上终结操作之前什么都不做 ===
+    std::cout << "\n--- 惰性流水线演示 ---\n";
+    const auto isEven = [](int x) { return x % 2 == 0; };
+    const auto evenSquares = vec | pipeline::filter(isEven) | pipeline::transform([](int x) { return x * x; });
+    std::cout << "偶数的平方和: " << (evenSquares | pipeline::sum()) << "\n";
+    MyVector<int> firstTwo = evenSquares | pipeline::take(2) | pipeline::collect<MyVector<int>>();
+    std::cout << "前两个偶数的平方 (MyVector): " << firstTwo[0] << " " << firstTwo[1] << "\n";
+    printVec(vec | pipeline::filter([](int x) { return x > 6; }) | pipeline::collect<std::vector<int>>());
+    std::cout << "直接写到输出流: ";
+    evenSquares | pipeline::collectTo(std::ostream_iterator<int>(std::cout, " "));
+    std::cout << "\n最长的单词: "
+              << (std::vector<std::string>{"pipeline", "fused", "lazy"} | pipeline::reduce(std::string(), [](std::string best, const std::string& word) {
+                      return word.size() > best.size() ? word : best;
+                  }))
+              << "\n";
+
+    // === 从文件流式过滤 (见 vector_stream_filter.hpp)：临时目录里的小文件，用完删除 ===
+    std::cout << "\n--- 从文件流式过滤演示 ---\n";
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const std::filesystem::path input = directory / "vector_string_examples_input.txt";
+    const std::filesystem::path output = directory / "vector_string_examples_output.txt";
+    {
+        std::ofstream text(input);
+        for (int x : vec) text << x * 7 << '\n';
+    }
+    const StreamFilterStats stats = filterEvensFile(input.string(), output.string(), IntFileFormat::Text);
+    std::ifstream filtered(output);
+    std::cout << "保留 " << stats.kept << " / " << stats.values << ": ";
+    for (int x; filtered >> x;) std::cout << x << " ";
+    std::cout << "\n";
+    filtered.close();
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+
+    // 大数组上的性能对比见 vector_string_benchmark.cpp
     return 0;
 }
@@ -1,16 +1,19 @@
 #include <iostream>
 #include <string>
+#include <string_view>
+
+#include "string_intern.hpp" // InternedString：ID 只保存一份，对象里存 4 字节的编号
 
 // --- 基类 (父类) ---
 class GameObject {
 protected: // 使用 protected 使得派生类可以访问这些成员
     double x_ = 0.0, y_ = 0.0; // 位置坐标
-    std::string id_;           // 唯一标识符
+    InternedString id_;        // 唯一标识符
 
 public:
     // 基类的构造函数
     // 初始化 id, x, 和 y 成员。
-    GameObject(const std::string& id, double x, double y)
+    GameObject(std::string_view id, double x, double y)
         : id_(id), x_(x), y_(y) {
         std::cout << "GameObject '" << id_ << "' 已构造。\n";
     }
@@ -30,7 +33,8 @@ public:
     }
 
     // 返回游戏对象的 ID。
-    std::string getId() const { return id_; }
+    // 返回的是 4 字节的句柄而不是 std::string 的拷贝，比较两个 ID 只是比较两个整数。
+    InternedString getId() const { return id_; }
 };
 
 // --- 派生类 1 (子类) ---
@@ -43,7 +47,7 @@ private:
 public:
     // 派生类构造函数必须调用基类构造函数。
     // 这确保了 Player 的 GameObject 部分能够被正确初始化。
-    Player(const std::string& name, double x, double y)
+    Player(std::string_view name, double x, double y)
         // 这行代码首先调用 GameObject 的构造函数
         : GameObject(name, x, y) {
         std::cout << "  -> Player '" << name << "' 的特定部分已构造。\n";
@@ -72,7 +76,7 @@ private:
 public:
     // Enemy 类的构造函数
     // 调用基类构造函数并初始化自己的成员。
-    Enemy(const std::string& type, double x, double y, int damage)
+    Enemy(std::string_view type, double x, double y, int damage)
         : GameObject(type, x, y), damage_(damage) {
         std::cout << "  -> Enemy '" << type << "' 的特定部分已构造。\n";
     }
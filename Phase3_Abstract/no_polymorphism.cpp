@@ -1,26 +1,29 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <string_view>
+
+#include "string_intern.hpp" // InternedString
 
 // 基类
 class Creature {
 protected:
-    std::string name_;
+    InternedString name_; // 所有 Goblin 共用同一份 "Goblin"
 public:
-    Creature(const std::string& name) : name_(name) {}
+    Creature(std::string_view name) : name_(name) {}
 
     // 注意：这是一个普通的、非虚的函数
     void attack() const {
         std::cout << "Creature " << name_ << " performs a generic attack!\n";
     }
 
-    std::string getName() const { return name_; }
+    InternedString getName() const { return name_; }
 };
 
 // 派生类
 class Player : public Creature {
 public:
-    Player(const std::string& name) : Creature(name) {}
+    Player(std::string_view name) : Creature(name) {}
 
     void attack() const { // 试图“覆盖”基类的函数
         std::cout << "Player " << name_ << " swings a sword!\n";
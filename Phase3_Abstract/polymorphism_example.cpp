@@ -2,15 +2,19 @@
 #include <string>   // 用于字符串操作
 #include <vector>   // 用于动态数组（向量）
 #include <memory>   // 用于智能指针，如 std::unique_ptr
+#include <string_view> // 用于 std::string_view
+
+#include "string_intern.hpp" // InternedString：名字只保存一份，对象里存 4 字节的编号
 
 // --- 基类：定义了多态的接口 ---
 class GameObject {
 protected:
-    std::string name_; // 游戏对象的名称
+    // 游戏对象的名称。成千上万个 "Goblin" 共用同一份字符，比较名字只是比较一个整数
+    InternedString name_;
 
 public:
     // 构造函数：接收对象名称
-    GameObject(const std::string& name) : name_(name) {}
+    GameObject(std::string_view name) : name_(name) {}
 
     // 1. 虚析构函数：对于多态基类是至关重要的！
     // 当我们通过基类指针删除派生类对象时，这能确保调用正确的派生类析构函数。
@@ -24,8 +28,8 @@ public:
         std::cout << name_ << " (一个通用的 GameObject) 只是存在着。\n";
     }
 
-    // 获取对象名称
-    std::string getName() const { return name_; }
+    // 获取对象名称（按值返回 4 字节的句柄，不会复制字符串）
+    InternedString getName() const { return name_; }
 };
 
 // --- 一个纯抽象类（接口）---
@@ -49,7 +53,7 @@ private:
 
 public:
     // 构造函数：调用基类构造函数，并初始化玩家特有成员
-    Player(const std::string& name) : GameObject(name) {}
+    Player(std::string_view name) : GameObject(name) {}
 
     // 派生类析构函数：使用 'override' 关键字明确表示重写基类虚函数
     // 'override' 是 C++11 的关键字，强烈推荐使用。
@@ -76,7 +80,7 @@ private:
 
 public:
     // 构造函数：调用基类构造函数，并初始化敌人特有成员
-    Enemy(const std::string& name, int damage) : GameObject(name), damage_(damage) {}
+    Enemy(std::string_view name, int damage) : GameObject(name), damage_(damage) {}
 
     // 派生类析构函数，同样使用 override 关键字
     ~Enemy() override {
@@ -93,7 +97,7 @@ public:
 class Scenery : public GameObject { // Scenery 继承自 GameObject
 public:
     // 构造函数
-    Scenery(const std::string& name) : GameObject(name) {}
+    Scenery(std::string_view name) : GameObject(name) {}
 
     // 派生类析构函数
     ~Scenery() override {
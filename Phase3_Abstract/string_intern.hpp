@@ -0,0 +1,250 @@
+#pragma once
+
+#include <atomic>       // std::atomic
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t
+#include <cstring>      // std::memcpy
+#include <functional>   // std::hash
+#include <limits>       // std::numeric_limits
+#include <memory>       // std::unique_ptr
+#include <mutex>        // std::unique_lock
+#include <optional>     // std::optional
+#include <ostream>      // std::ostream
+#include <shared_mutex> // std::shared_mutex, std::shared_lock
+#include <stdexcept>    // std::length_error
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <unordered_map> // std::unordered_map
+#include <vector>       // std::vector
+
+// 字符串驻留 (interning)：每个不同的字符串在整个程序里只保存一份，对象里只存一个 32 位的编号。
+//
+// 几百万个游戏对象往往只用到几千个不同的名字 ("Goblin"、"Oak Tree" ...)。
+// 每个对象各自持有一个 std::string 时，同样的字符重复存了几百万遍，
+// getName() 按值返回时每次调用还要再复制 (可能还要分配) 一次。
+// 换成 InternedString 之后：
+// - 对象里只有 4 个字节，拷贝就是拷贝一个整数
+// - 相等比较、哈希都是比较 / 使用编号，与字符串长度无关
+// - view() 用编号直接找到字符串，O(1) 且不加锁
+//
+// StringPool 的实现：
+// - 字符依次存放在 64 KB 的内存块里 (末尾带 '\0')，块永远不会移动或释放，所以 string_view 一直有效
+// - 编号 -> string_view 的表分段存储 (第 k 段有 1024 * 2^k 项)，段一旦分配就不再移动，
+//   查找时不需要加锁
+// - 字符串 -> 编号用 unordered_map，读写锁保护：已经存在的名字只需要共享锁，
+//   多个线程可以同时查找；只有第一次出现的名字才需要独占锁
+//
+// 编号 0 永远是空字符串，默认构造的 InternedString 就是它。
+// 字符串一旦驻留就不会被释放 (名字的集合是有限的)，不适合存放用户输入之类无限增长的数据。
+class StringPool
+{
+private:
+    static constexpr std::size_t kBlockSize {64 * 1024};
+    static constexpr std::size_t kFirstSegmentBits {10};
+    static constexpr std::size_t kFirstSegment {std::size_t {1} << kFirstSegmentBits};
+    // 所有段加起来覆盖 32 位的编号
+    static constexpr std::size_t kSegmentCount {32 - kFirstSegmentBits + 1};
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string_view, std::uint32_t> ids_;
+    std::atomic<std::string_view*> segments_[kSegmentCount] {};
+    std::size_t count_ {0};
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* block_ {nullptr}; // 当前正在填充的块
+    std::size_t blockUsed_ {kBlockSize};
+    std::size_t bytes_ {0};
+
+    // 编号 i 在第 k 段：第 k 段的第一个编号是 kFirstSegment * (2^k - 1)
+    static std::size_t segmentOf(std::size_t i)
+    {
+        const std::size_t highestBit {static_cast<std::size_t>(std::numeric_limits<unsigned long long>::digits - 1
+                                                               - __builtin_clzll(i + kFirstSegment))};
+        return highestBit - kFirstSegmentBits;
+    }
+
+    static std::size_t segmentStart(std::size_t k) { return (kFirstSegment << k) - kFirstSegment; }
+
+    // 把字符复制到内存块里 (调用者持有独占锁)
+    std::string_view store(std::string_view text)
+    {
+        const std::size_t bytes {text.size() + 1};
+        char* destination {nullptr};
+        if (bytes > kBlockSize / 4)
+        {
+            // 很长的字符串单独占一块，不浪费当前块剩下的空间
+            blocks_.push_back(std::unique_ptr<char[]>(new char[bytes]));
+            destination = blocks_.back().get();
+        }
+        else
+        {
+            if (blockUsed_ + bytes > kBlockSize)
+            {
+                blocks_.push_back(std::unique_ptr<char[]>(new char[kBlockSize]));
+                block_ = blocks_.back().get();
+                blockUsed_ = 0;
+            }
+            destination = block_ + blockUsed_;
+            blockUsed_ += bytes;
+        }
+        if (!text.empty())
+        {
+            std::memcpy(destination, text.data(), text.size());
+        }
+        destination[text.size()] = '\0';
+        bytes_ += bytes;
+        return {destination, text.size()};
+    }
+
+    // 追加一项 (调用者持有独占锁)，返回它的编号
+    std::uint32_t append(std::string_view text)
+    {
+        if (count_ > std::numeric_limits<std::uint32_t>::max())
+        {
+            throw std::length_error("StringPool: more than 2^32 distinct strings");
+        }
+        const std::size_t k {segmentOf(count_)};
+        std::string_view* segment {segments_[k].load(std::memory_order_relaxed)};
+        if (segment == nullptr)
+        {
+            segment = new std::string_view[kFirstSegment << k];
+            segments_[k].store(segment, std::memory_order_release);
+        }
+        segment[count_ - segmentStart(k)] = text;
+        ids_.emplace(text, static_cast<std::uint32_t>(count_));
+        return static_cast<std::uint32_t>(count_++);
+    }
+
+public:
+    StringPool()
+    {
+        append(store({}));
+    }
+
+    ~StringPool()
+    {
+        for (auto& segment : segments_)
+        {
+            delete[] segment.load(std::memory_order_relaxed);
+        }
+    }
+
+    // 段表被 view() 无锁读取，池不能拷贝或移动
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    // 返回 text 的编号，第一次出现时复制一份保存下来
+    std::uint32_t intern(std::string_view text)
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock {mutex_};
+            const auto found {ids_.find(text)};
+            if (found != ids_.end())
+            {
+                return found->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock {mutex_};
+        // 释放共享锁之后，别的线程可能已经插入了同一个字符串
+        const auto found {ids_.find(text)};
+        if (found != ids_.end())
+        {
+            return found->second;
+        }
+        return append(store(text));
+    }
+
+    // 只查找不插入：text 不在池中时返回 std::nullopt (用于比较，池不会因为比较而增长)
+    std::optional<std::uint32_t> find(std::string_view text) const
+    {
+        std::shared_lock<std::shared_mutex> lock {mutex_};
+        const auto found {ids_.find(text)};
+        if (found == ids_.end())
+        {
+            return std::nullopt;
+        }
+        return found->second;
+    }
+
+    // 编号必须来自这个池的 intern (并且已经通过某种同步传到当前线程)
+    std::string_view view(std::uint32_t id) const
+    {
+        const std::size_t k {segmentOf(id)};
+        return segments_[k].load(std::memory_order_acquire)[id - segmentStart(k)];
+    }
+
+    // 不同字符串的个数 (包括空字符串)
+    std::size_t size() const
+    {
+        std::shared_lock<std::shared_mutex> lock {mutex_};
+        return count_;
+    }
+
+    // 保存的字符总数 (包括每个字符串末尾的 '\0')
+    std::size_t bytes() const
+    {
+        std::shared_lock<std::shared_mutex> lock {mutex_};
+        return bytes_;
+    }
+};
+
+// 整个程序共用的池
+inline StringPool& globalStringPool()
+{
+    static StringPool pool;
+    return pool;
+}
+
+// 驻留在 globalStringPool() 中的字符串的句柄
+class InternedString
+{
+private:
+    std::uint32_t id_ {0};
+
+public:
+    InternedString() = default;
+
+    // explicit：驻留的字符串永远不会释放，只有明确地构造 InternedString 时才加入池中，
+    // 不会在 name == "x" 这样的比较里被隐式转换、悄悄地加进去
+    explicit InternedString(std::string_view text) : id_{globalStringPool().intern(text)} {}
+    explicit InternedString(const char* text) : InternedString{std::string_view {text}} {}
+    explicit InternedString(const std::string& text) : InternedString{std::string_view {text}} {}
+
+    std::uint32_t id() const { return id_; }
+    std::string_view view() const { return globalStringPool().view(id_); }
+    const char* c_str() const { return view().data(); } // 保存时末尾带了 '\0'
+    std::string str() const { return std::string {view()}; }
+    bool empty() const { return id_ == 0; }
+
+    // 同一个字符串只有一个编号，所以比较编号就是比较内容
+    friend bool operator==(InternedString a, InternedString b) { return a.id_ == b.id_; }
+    friend bool operator!=(InternedString a, InternedString b) { return a.id_ != b.id_; }
+
+    // 与普通字符串比较：只在池中查找，不插入。text 不在池中就不可能与任何 InternedString 相等
+    friend bool operator==(InternedString a, std::string_view text)
+    {
+        const std::optional<std::uint32_t> id {globalStringPool().find(text)};
+        return id.has_value() && *id == a.id_;
+    }
+    friend bool operator==(std::string_view text, InternedString a) { return a == text; }
+    friend bool operator!=(InternedString a, std::string_view text) { return !(a == text); }
+    friend bool operator!=(std::string_view text, InternedString a) { return !(a == text); }
+
+    // 按编号排序 (即第一次驻留的先后顺序，不是字典序)，可以作为 std::map / std::set 的键；
+    // 需要字典序时比较 view()
+    friend bool operator<(InternedString a, InternedString b) { return a.id_ < b.id_; }
+
+    friend std::ostream& operator<<(std::ostream& os, InternedString s)
+    {
+        return os << s.view();
+    }
+};
+
+// 编号本身就是很好的哈希值：不同的字符串编号一定不同
+namespace std
+{
+    template <>
+    struct hash<InternedString>
+    {
+        std::size_t operator()(InternedString s) const noexcept { return s.id(); }
+    };
+}
@@ -0,0 +1,163 @@
+#include <chrono>        // 用于计时
+#include <cstddef>       // std::size_t
+#include <iostream>      // 用于输入输出流操作
+#include <map>           // 以 InternedString 为键的有序容器
+#include <string>        // 用于字符串操作
+#include <thread>        // std::thread
+#include <unordered_map> // 按名字分组计数
+#include <vector>        // 用于动态数组（向量）
+
+#include "string_intern.hpp" // StringPool, InternedString
+
+// 几百万个实体，只有几千个不同的名字：对比每个实体自带 std::string 和使用 InternedString。
+// 编译：g++ -std=c++17 -O2 -pthread string_intern_example.cpp -o string_intern_example
+
+struct EntityWithString {
+    std::string name;
+    float x, y;
+};
+
+struct EntityWithInterned {
+    InternedString name;
+    float x, y;
+};
+
+template <typename Func>
+double measureMs(Func&& func) {
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// std::string 自己占用的字节数 + 超出短字符串优化 (SSO) 时在堆上分配的字节数
+std::size_t stringBytes(const std::string& s) {
+    const bool onHeap = s.data() < reinterpret_cast<const char*>(&s) ||
+                        s.data() >= reinterpret_cast<const char*>(&s + 1);
+    return sizeof(std::string) + (onHeap ? s.capacity() + 1 : 0);
+}
+
+int main() {
+    const std::size_t entityCount = 2'000'000;
+    const std::size_t nameCount = 3'000;
+
+    // 名字都超过 15 个字符，std::string 必须在堆上分配
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < nameCount; ++i) {
+        names.push_back("Goblin Warrior of Clan #" + std::to_string(i));
+    }
+
+    std::vector<EntityWithString> plain;
+    std::vector<EntityWithInterned> interned;
+    plain.reserve(entityCount);
+    interned.reserve(entityCount);
+
+    std::cout << "--- 创建 " << entityCount << " 个实体 (" << nameCount << " 个不同的名字) ---\n";
+    const double plainBuild = measureMs([&] {
+        for (std::size_t i = 0; i < entityCount; ++i) {
+            plain.push_back({names[i % nameCount], 0.0f, 0.0f});
+        }
+    });
+    const double internedBuild = measureMs([&] {
+        for (std::size_t i = 0; i < entityCount; ++i) {
+            interned.push_back({InternedString(names[i % nameCount]), 0.0f, 0.0f});
+        }
+    });
+    std::cout << "std::string:    " << plainBuild << " ms\n";
+    std::cout << "InternedString: " << internedBuild << " ms\n";
+
+    std::size_t plainBytes = 0;
+    for (const auto& e : plain) {
+        plainBytes += sizeof(e) - sizeof(e.name) + stringBytes(e.name);
+    }
+    const std::size_t internedBytes = interned.size() * sizeof(EntityWithInterned) + globalStringPool().bytes();
+    std::cout << "\n--- 内存 ---\n";
+    std::cout << "sizeof(EntityWithString) = " << sizeof(EntityWithString)
+              << ", sizeof(EntityWithInterned) = " << sizeof(EntityWithInterned) << "\n";
+    std::cout << "std::string:    " << plainBytes / (1024 * 1024) << " MB\n";
+    std::cout << "InternedString: " << internedBytes / (1024 * 1024) << " MB (池中 "
+              << globalStringPool().size() << " 个字符串，共 " << globalStringPool().bytes() << " 字节)\n";
+
+    // 比较名字：std::string 要比较长度和内容，InternedString 只比较编号
+    std::cout << "\n--- 统计名字等于 \"" << names[42] << "\" 的实体 ---\n";
+    std::size_t plainMatches = 0, internedMatches = 0;
+    const double plainCompare = measureMs([&] {
+        const std::string& target = names[42];
+        for (const auto& e : plain) {
+            plainMatches += e.name == target;
+        }
+    });
+    const double internedCompare = measureMs([&] {
+        const InternedString target(names[42]);
+        for (const auto& e : interned) {
+            internedMatches += e.name == target;
+        }
+    });
+    std::cout << "std::string:    " << plainCompare << " ms (" << plainMatches << " 个)\n";
+    std::cout << "InternedString: " << internedCompare << " ms (" << internedMatches << " 个)\n";
+
+    // 按名字分组：std::string 每次都要哈希整个字符串，InternedString 的哈希就是编号
+    std::cout << "\n--- 按名字分组计数 ---\n";
+    std::unordered_map<std::string, std::size_t> plainGroups;
+    std::unordered_map<InternedString, std::size_t> internedGroups;
+    const double plainGroup = measureMs([&] {
+        for (const auto& e : plain) {
+            ++plainGroups[e.name];
+        }
+    });
+    const double internedGroup = measureMs([&] {
+        for (const auto& e : interned) {
+            ++internedGroups[e.name];
+        }
+    });
+    std::cout << "std::string:    " << plainGroup << " ms (" << plainGroups.size() << " 组)\n";
+    std::cout << "InternedString: " << internedGroup << " ms (" << internedGroups.size() << " 组)\n";
+
+    // 多个线程同时驻留同样的名字，得到的编号必须完全相同
+    std::cout << "\n--- 多线程驻留 ---\n";
+    const unsigned threadCount = 4;
+    std::vector<std::vector<InternedString>> results(threadCount);
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t] {
+            for (std::size_t i = 0; i < nameCount; ++i) {
+                results[t].emplace_back("Orc Shaman #" + std::to_string((i * (t + 1)) % nameCount));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    bool consistent = true;
+    for (unsigned t = 0; t < threadCount; ++t) {
+        for (std::size_t i = 0; i < nameCount; ++i) {
+            const std::string expected = "Orc Shaman #" + std::to_string((i * (t + 1)) % nameCount);
+            consistent = consistent && results[t][i].view() == expected && results[t][i] == InternedString(expected);
+        }
+    }
+    std::cout << (consistent ? "所有线程得到的编号一致" : "错误：编号不一致") << "，池中现在有 "
+              << globalStringPool().size() << " 个字符串\n";
+
+    // 与普通字符串比较只查找、不插入：比较一个从没出现过的名字，池的大小不变
+    std::cout << "\n--- 与普通字符串比较 ---\n";
+    const std::size_t poolSize = globalStringPool().size();
+    std::size_t dragons = 0;
+    for (const auto& e : interned) {
+        dragons += e.name == "Ancient Red Dragon";
+    }
+    const bool poolUnchanged = globalStringPool().size() == poolSize;
+    std::cout << "名字是 \"Ancient Red Dragon\" 的实体: " << dragons << " 个，池的大小"
+              << (poolUnchanged ? "没有变化" : "变了!") << "；" << names[7] << " == interned[7].name: "
+              << (interned[7].name == names[7] ? "是" : "否") << "\n";
+
+    // InternedString 可以直接作为有序容器的键 (按编号排序)
+    std::map<InternedString, int> bounty;
+    bounty[interned[0].name] += 10;
+    bounty[interned[1].name] += 20;
+    bounty[interned[nameCount].name] += 5; // 与 interned[0] 同名
+    std::cout << "std::map 中有 " << bounty.size() << " 个键，" << interned[0].name << " 的赏金 " << bounty[interned[0].name]
+              << "\n";
+
+    consistent = consistent && poolUnchanged;
+
+    return consistent ? 0 : 1;
+}
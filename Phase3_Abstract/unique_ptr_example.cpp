@@ -1,11 +1,14 @@
 #include <iostream>
 #include <memory> // 包含 <memory> 头文件以使用智能指针
 #include <string>
+#include <string_view>
+
+#include "string_intern.hpp" // InternedString
 
 // 一个简单的游戏对象，方便我们追踪其生命周期
 struct GameObject {
-    std::string name;
-    GameObject(const std::string& n) : name(n) {
+    InternedString name; // 同名的对象共用一份字符串
+    GameObject(std::string_view n) : name(n) {
         std::cout << "  [+] GameObject '" << name << "' has been created.\n";
     }
     ~GameObject() {